@@ -45,6 +45,7 @@
 
 /* USER CODE BEGIN Includes */
 /* Section where include file can be added */
+#include <cpu_profile.h>
 /* USER CODE END Includes */
 
 /* Ensure definitions are only used by the compiler, and not by the assembler. */
@@ -69,6 +70,7 @@
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_TICKLESS_IDLE                  1
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
 /* USER CODE BEGIN MESSAGE_BUFFER_LENGTH_TYPE */
 /* Defaults to size_t for backward compatibility, but can be changed
@@ -137,6 +139,25 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+#if configUSE_TICKLESS_IDLE == 1
+/* Tickless idle hooks, freertos.c: keep the HAL timebase from ending every
+   sleep after one millisecond. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void PreSleepProcessing(uint32_t *ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t *ulExpectedIdleTime);
+#endif
+#define configPRE_SLEEP_PROCESSING( x )  PreSleepProcessing( &( x ) )
+#define configPOST_SLEEP_PROCESSING( x ) PostSleepProcessing( &( x ) )
+#endif /* configUSE_TICKLESS_IDLE == 1 */
+#if CPU_PROFILE
+/* Run-time stats and per task / per interrupt accounting on the DWT cycle
+   counter, see cpu_profile.h. */
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() cpu_profile_init()
+#define portGET_RUN_TIME_COUNTER_VALUE()         cpu_profile_cycles()
+#define traceTASK_SWITCHED_OUT()                 cpu_profile_task_switched_out( pxCurrentTCB )
+#define traceTASK_SWITCHED_IN()                  cpu_profile_task_switched_in( pxCurrentTCB )
+#endif /* CPU_PROFILE */
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,169 @@
+/*
+ * cpu_profile.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __CPU_PROFILE_H__
+#define __CPU_PROFILE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+ * CPU_PROFILE: 1 accounts DWT CYCCNT cycles per FreeRTOS task and per
+ * interrupt handler listed in CPU_PROFILE_IRQS, and enables
+ * configGENERATE_RUN_TIME_STATS on the same counter. Task time excludes
+ * the time spent in the listed handlers; other interrupts are charged to
+ * the task they interrupt. CYCCNT stops while the core sleeps, so the sum
+ * of all entries is awake time; the snapshot carries the tick count for
+ * wall time.
+ */
+#ifndef CPU_PROFILE
+#define CPU_PROFILE 0
+#endif
+
+/*
+ * CPU_PROFILE_MAX_TASKS: tasks accounted individually, in order of their
+ * first switch in. Switches to further tasks are counted, not timed.
+ */
+#ifndef CPU_PROFILE_MAX_TASKS
+#define CPU_PROFILE_MAX_TASKS 8
+#endif
+
+/**
+ * @brief Interrupt handlers accounted, X(name) per handler name without
+ * the _IRQHandler suffix. Each is charged its own cycles only: a handler
+ * preempting another (TIM1_UP runs at priority 15) is not counted twice.
+ * All peripheral handlers of stm32f1xx_it.c are listed; SysTick and the
+ * scheduler's PendSV and SVC are charged to the task they interrupt.
+ */
+#define CPU_PROFILE_IRQS(X) \
+	X(DMA1_Channel2) \
+	X(DMA1_Channel3) \
+	X(DMA1_Channel4) \
+	X(DMA1_Channel5) \
+	X(DMA1_Channel6) \
+	X(DMA1_Channel7) \
+	X(USART1) \
+	X(USART2) \
+	X(USART3) \
+	X(TIM1_UP) \
+	X(TIM2) \
+	X(TIM3)
+
+#define CPU_PROFILE_IRQ_ENUM(name) CPU_PROFILE_IRQ_##name,
+typedef enum {
+	CPU_PROFILE_IRQS(CPU_PROFILE_IRQ_ENUM)
+	CPU_PROFILE_IRQ_COUNT
+} cpu_profile_irq_id_t;
+#undef CPU_PROFILE_IRQ_ENUM
+
+/*
+ * Snapshot format, little-endian, no padding:
+ *
+ *   header    u32 magic, u8 version, u8 name length N, u8 task count,
+ *             u8 interrupt count, u32 CPU clock in Hz, u32 tick rate in Hz,
+ *             u32 tick count, u32 switches to untracked tasks
+ *   task      N bytes name (NUL padded), u64 cycles, u32 switches in
+ *   interrupt N bytes name (NUL padded), u64 cycles, u32 count, u32 longest
+ *
+ * Tools/ring_bench/cpu_profile_decode.c prints it.
+ */
+#define CPU_PROFILE_MAGIC           0x50555043u     /* "CPUP" */
+#define CPU_PROFILE_VERSION         1u
+#define CPU_PROFILE_HEADER_SIZE     24u
+#define CPU_PROFILE_TASK_SIZE(n)    ((n) + 12u)
+#define CPU_PROFILE_IRQ_SIZE(n)     ((n) + 16u)
+#define CPU_PROFILE_SNAPSHOT_MAX_SIZE(n) (CPU_PROFILE_HEADER_SIZE \
+		+ CPU_PROFILE_MAX_TASKS * CPU_PROFILE_TASK_SIZE(n) + CPU_PROFILE_IRQ_COUNT * CPU_PROFILE_IRQ_SIZE(n))
+
+/**
+ * @brief Counter values at handler entry.
+ */
+typedef struct {
+	uint32_t start;         /**< Cycle count */
+	uint32_t irq_cycles;    /**< Handler cycles accounted so far, for nested handlers */
+} cpu_profile_irq_mark_t;
+
+#if CPU_PROFILE
+/**
+ * @brief Mark handler entry.
+ *
+ * Declares a local, place first in the handler and pair with
+ * CPU_PROFILE_IRQ_EXIT() on every return path.
+ */
+#define CPU_PROFILE_IRQ_ENTER(name) cpu_profile_irq_mark_t cpu_profile_irq_mark = cpu_profile_irq_enter()
+#define CPU_PROFILE_IRQ_EXIT(name)  cpu_profile_irq_exit(CPU_PROFILE_IRQ_##name, cpu_profile_irq_mark)
+
+/**
+ * @brief Enable the DWT cycle counter.
+ *
+ * Called by the scheduler as portCONFIGURE_TIMER_FOR_RUN_TIME_STATS().
+ */
+void cpu_profile_init(void);
+
+/**
+ * @brief Current DWT cycle count, portGET_RUN_TIME_COUNTER_VALUE().
+ * @return Free-running cycle count.
+ */
+uint32_t cpu_profile_cycles(void);
+
+/**
+ * @brief Account the task being switched out, traceTASK_SWITCHED_OUT().
+ * @param task Handle of the running task.
+ */
+void cpu_profile_task_switched_out(const void* task);
+
+/**
+ * @brief Start accounting the task switched in, traceTASK_SWITCHED_IN().
+ * @param task Handle of the task selected to run.
+ */
+void cpu_profile_task_switched_in(const void* task);
+
+/**
+ * @brief Read the counters at handler entry.
+ * @return Mark to pass to cpu_profile_irq_exit().
+ */
+cpu_profile_irq_mark_t cpu_profile_irq_enter(void);
+
+/**
+ * @brief Account one run of an interrupt handler, less the handlers that
+ * preempted it.
+ * @param id Handler.
+ * @param mark Counters at handler entry.
+ */
+void cpu_profile_irq_exit(cpu_profile_irq_id_t id, cpu_profile_irq_mark_t mark);
+
+/**
+ * @brief Clear all task and interrupt statistics.
+ */
+void cpu_profile_reset(void);
+
+/**
+ * @brief Write a snapshot of the statistics in the binary format above.
+ *
+ * Call from a task; the calling task is accounted up to the call.
+ *
+ * @param buffer Destination.
+ * @param size Destination size in bytes.
+ * @return Snapshot length, 0 if it does not fit.
+ */
+size_t cpu_profile_snapshot(uint8_t* buffer, size_t size);
+#else
+#define CPU_PROFILE_IRQ_ENTER(name)
+#define CPU_PROFILE_IRQ_EXIT(name)
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,22 +9,45 @@
 #define __DMA_RING_BUFFER_H__
 
 #include <ring_buffer.h>
+#include <mp_ring_buffer.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief TX side: ring filled by any number of tasks, drained by DMA.
+ *
+ * dma_busy is the TX DMA channel ownership flag. It is taken with an
+ * atomic compare-and-swap so tasks and ISRs never start the channel twice.
+ */
 typedef struct {
-	ring_buffer_t* ring_buffer;
+	mp_ring_buffer_t* ring_buffer;
     size_t dma_last_size;
     int dma_busy;
+    uint32_t released_total;    /**< Bytes released by completed transfers, free-running */
 } dma_producer_ring_t;
 
+/**
+ * @brief RX side: ring filled by DMA, drained by tasks.
+ *
+ * In normal mode DMA is re-armed for each contiguous free block. In
+ * circular mode DMA runs over the whole ring without stopping and the
+ * write position is taken from the channel counter (CNDTR) on every
+ * half-transfer, transfer-complete and IDLE event. After a USART error
+ * stopped it, circular DMA can only restart at the ring start: until the
+ * write index gets there, reception continues in normal mode.
+ */
 typedef struct {
 	ring_buffer_t* ring_buffer;
     size_t dma_last_size;
     size_t dma_received_during_current_transfer;
     int dma_busy;
+    int dma_circular;           /**< DMA runs in circular mode over the whole ring */
+    size_t dma_position;        /**< Circular mode: ring offset DMA writes next */
+    int dma_overrun;            /**< Circular mode: DMA overwrote unread data, resync pending */
+    uint32_t dma_overrun_count; /**< Circular mode: number of overruns detected */
+    int dma_circular_resume;    /**< Circular mode suspended after an error, resumed at the ring start */
 } dma_consumer_ring_t;
 
 
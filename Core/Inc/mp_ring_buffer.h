@@ -0,0 +1,202 @@
+/*
+ * mp_ring_buffer.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __MP_RING_BUFFER_H__
+#define __MP_RING_BUFFER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pow2_ring_buffer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Largest supported ring size.
+ *
+ * Indices are 16-bit free-running values packed next to the writer count
+ * in one 32-bit word. A committer compares its reservation end against
+ * commit_index as a signed 16-bit distance, which stays unambiguous only
+ * while reservations are at most a quarter of the index range ahead of or
+ * behind commit_index, so the ring is limited to 16384 bytes.
+ */
+#define MP_RING_BUFFER_MAX_SIZE 16384u
+
+/**
+ * @brief Check whether @p size is a valid multi-producer ring length.
+ */
+#define MP_RING_BUFFER_IS_VALID_SIZE(size) \
+	(POW2_RING_BUFFER_IS_VALID_SIZE(size) && (size) <= MP_RING_BUFFER_MAX_SIZE)
+
+/**
+ * @brief Static initializer for a multi-producer ring buffer.
+ * @param storage Backing byte array.
+ * @param size Array length, power of two up to MP_RING_BUFFER_MAX_SIZE.
+ */
+#define MP_RING_BUFFER_INIT(storage, size) \
+	{ .data = (storage), .mask = (size) - 1, .reserve_state = 0, .commit_index = 0, .read_index = 0 }
+
+/**
+ * @brief Define backing storage and descriptor of a multi-producer ring buffer.
+ *
+ * Fails to compile when @p size is not a valid ring size.
+ */
+#define MP_RING_BUFFER_DEFINE(name, size) \
+	_Static_assert(MP_RING_BUFFER_IS_VALID_SIZE(size), #name " size must be a power of two <= 16384"); \
+	uint8_t name##_data[size]; \
+	mp_ring_buffer_t name = MP_RING_BUFFER_INIT(name##_data, size)
+
+
+/**
+ * @brief Multi-producer / single-consumer ring buffer.
+ *
+ * Any number of tasks or ISRs may enqueue concurrently without a mutex:
+ *  1. mp_ring_buffer_reserve() atomically claims space and registers
+ *     the caller as an active writer,
+ *  2. the caller fills the claimed space (mp_ring_buffer_copy_in()),
+ *  3. mp_ring_buffer_commit() unregisters the writer. The writer that
+ *     brings the active count to zero publishes everything reserved so
+ *     far, so the consumer only ever sees data in reservation order and
+ *     never a half-written region.
+ * No producer ever waits for another one or for the consumer.
+ *
+ * The single consumer (TX DMA) reads up to commit_index and releases
+ * space by advancing read_index.
+ */
+typedef struct {
+    uint8_t*              data;          /**< Pointer to raw buffer memory */
+    size_t                mask;          /**< Buffer size in bytes minus one */
+    atomic_uint_least32_t reserve_state; /**< Bits 0-15 reserve index, bits 16-31 active writers */
+    atomic_uint_least32_t commit_index;  /**< Data below this index is readable */
+    atomic_uint_least32_t read_index;    /**< Consumer position, owned by consumer */
+} mp_ring_buffer_t;
+
+/**
+ * @brief Initialize ring buffer over caller provided storage.
+ * @param rb Pointer to ring buffer instance.
+ * @param storage Backing memory.
+ * @param size Size of backing memory, see MP_RING_BUFFER_IS_VALID_SIZE().
+ * @return 0 on success, -1 if @p size is invalid.
+ */
+int mp_ring_buffer_init(mp_ring_buffer_t* rb, uint8_t* storage, size_t size);
+
+/**
+ * @brief Get total buffer size in bytes.
+ * @param rb Pointer to ring buffer instance.
+ * @return Buffer size.
+ */
+static inline size_t mp_ring_buffer_get_length(const mp_ring_buffer_t* rb)
+{
+	return rb->mask + 1;
+}
+
+/**
+ * @brief Get number of bytes not yet reserved by any producer.
+ *
+ * Only a snapshot: other producers may reserve concurrently.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of free bytes.
+ */
+size_t mp_ring_buffer_get_free_size(mp_ring_buffer_t* rb);
+
+/**
+ * @brief Atomically reserve @p len bytes for writing (producer side).
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes to reserve, 0 < len <= ring size.
+ * @param start Receives the index of the first reserved byte.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int mp_ring_buffer_reserve(mp_ring_buffer_t* rb, size_t len, uint32_t* start);
+
+/**
+ * @brief Reserve as many bytes as currently free, up to @p max_len.
+ * @param rb Pointer to ring buffer instance.
+ * @param max_len Maximum number of bytes to reserve.
+ * @param start Receives the index of the first reserved byte.
+ * @return Number of bytes reserved, 0 if the ring is full.
+ */
+size_t mp_ring_buffer_reserve_partial(mp_ring_buffer_t* rb, size_t max_len, uint32_t* start);
+
+/**
+ * @brief Copy data into reserved space, handling the wrap.
+ * @param rb Pointer to ring buffer instance.
+ * @param index Ring index to write at (inside a reservation).
+ * @param src Source data buffer.
+ * @param len Number of bytes to copy.
+ */
+void mp_ring_buffer_copy_in(mp_ring_buffer_t* rb, uint32_t index, const uint8_t* src, size_t len);
+
+/**
+ * @brief Finish a reservation made with mp_ring_buffer_reserve().
+ *
+ * Must be called exactly once per successful reservation, after its data
+ * has been written.
+ *
+ * @param rb Pointer to ring buffer instance.
+ */
+void mp_ring_buffer_commit(mp_ring_buffer_t* rb);
+
+/**
+ * @brief Reserve, copy and commit in one call.
+ *
+ * Same contract as ring_buffer_write(): the write is all or nothing.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param src Source data buffer.
+ * @param len Number of bytes to write.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int mp_ring_buffer_write(mp_ring_buffer_t* rb, const uint8_t* src, size_t len);
+
+/**
+ * @brief Get number of committed bytes readable by the consumer.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of readable bytes.
+ */
+size_t mp_ring_buffer_get_used_size(mp_ring_buffer_t* rb);
+
+/**
+ * @brief Get the linear committed block at the read position (consumer side).
+ *
+ * Used to size a TX DMA transfer.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param data Receives pointer to the first readable byte.
+ * @return Size of the block, 0 if nothing is committed.
+ */
+size_t mp_ring_buffer_peek_linear(mp_ring_buffer_t* rb, uint8_t** data);
+
+/**
+ * @brief Get the linear committed block @p offset bytes past the read position.
+ *
+ * Lets the consumer look at the block following one it is still
+ * transmitting, e.g. to prepare the next DMA transfer in advance.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param offset Distance from the read position in bytes.
+ * @param data Receives pointer to the first byte of the block.
+ * @return Size of the block, 0 if nothing is committed past @p offset.
+ */
+size_t mp_ring_buffer_peek_linear_at(mp_ring_buffer_t* rb, size_t offset, uint8_t** data);
+
+/**
+ * @brief Release @p len bytes after the consumer is done with them.
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes consumed.
+ */
+void mp_ring_buffer_release(mp_ring_buffer_t* rb, size_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MP_RING_BUFFER_H__ */
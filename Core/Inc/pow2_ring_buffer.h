@@ -0,0 +1,188 @@
+/*
+ * pow2_ring_buffer.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __POW2_RING_BUFFER_H__
+#define __POW2_RING_BUFFER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Check whether @p size is a valid power-of-two ring length.
+ *
+ * Usable in constant expressions (static asserts, array sizes).
+ */
+#define POW2_RING_BUFFER_IS_VALID_SIZE(size) \
+	((size) != 0 && (((size) & ((size) - 1)) == 0))
+
+/**
+ * @brief Static initializer for a power-of-two ring buffer.
+ * @param storage Backing byte array.
+ * @param size Array length, must be a power of two.
+ */
+#define POW2_RING_BUFFER_INIT(storage, size) \
+	{ .data = (storage), .head = 0, .tail = 0, .mask = (size) - 1 }
+
+/**
+ * @brief Define backing storage and descriptor of a power-of-two ring buffer.
+ *
+ * Fails to compile when @p size is not a power of two.
+ * Expands to `uint8_t name_data[size]` and `pow2_ring_buffer_t name`.
+ */
+#define POW2_RING_BUFFER_DEFINE(name, size) \
+	_Static_assert(POW2_RING_BUFFER_IS_VALID_SIZE(size), #name " size must be a power of two"); \
+	uint8_t name##_data[size]; \
+	pow2_ring_buffer_t name = POW2_RING_BUFFER_INIT(name##_data, size)
+
+
+/**
+ * @brief Power-of-two ring buffer descriptor (single-producer / single-consumer).
+ *
+ * Indices are free-running and never wrapped explicitly, the position in
+ * the backing array is obtained by masking. Used size is `tail - head`,
+ * so no cached free space counter is needed and no division is done on
+ * the hot path.
+ *
+ * Tail is advanced by producer (writer).
+ * Head is advanced by consumer (reader).
+ */
+typedef struct {
+    uint8_t* data;          /**< Pointer to raw buffer memory */
+    size_t   head;          /**< Free-running read index (consumer position) */
+    size_t   tail;          /**< Free-running write index (producer position) */
+    size_t   mask;          /**< Buffer size in bytes minus one */
+} pow2_ring_buffer_t;
+
+/**
+ * @brief Initialize ring buffer over caller provided storage.
+ * @param rb Pointer to ring buffer instance.
+ * @param storage Backing memory.
+ * @param size Size of backing memory, must be a power of two.
+ * @return 0 on success, -1 if @p size is not a power of two.
+ */
+int pow2_ring_buffer_init(pow2_ring_buffer_t* rb, uint8_t* storage, size_t size);
+
+/**
+ * @brief Get total buffer size in bytes.
+ * @param rb Pointer to ring buffer instance.
+ * @return Buffer size.
+ */
+static inline size_t pow2_ring_buffer_get_length(const pow2_ring_buffer_t* rb)
+{
+	return rb->mask + 1;
+}
+
+/**
+ * @brief Get number of bytes currently stored in buffer.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of used bytes.
+ */
+static inline size_t pow2_ring_buffer_get_used_size(const pow2_ring_buffer_t* rb)
+{
+	return rb->tail - rb->head;
+}
+
+/**
+ * @brief Get number of free bytes available for writing.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of free bytes.
+ */
+static inline size_t pow2_ring_buffer_get_free_size(const pow2_ring_buffer_t* rb)
+{
+	return pow2_ring_buffer_get_length(rb) - pow2_ring_buffer_get_used_size(rb);
+}
+
+/**
+ * @brief Write data into ring buffer.
+ *
+ * Same contract as ring_buffer_write(): the write is all or nothing.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param src Source data buffer.
+ * @param len Number of bytes to write.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int pow2_ring_buffer_write(
+    pow2_ring_buffer_t* rb,
+    const uint8_t* src,
+    size_t len
+);
+
+/**
+ * @brief Read data from ring buffer.
+ *
+ * Copies up to @p len bytes into destination buffer
+ * and advances read pointer.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param dst Destination buffer.
+ * @param len Number of bytes to read.
+ * @return Number of bytes actually read.
+ */
+size_t pow2_ring_buffer_read(
+    pow2_ring_buffer_t* rb,
+    uint8_t* dst,
+    size_t len
+);
+
+/**
+ * @brief Advance read pointer without copying data.
+ *
+ * Used when data is drained directly by hardware (e.g. TX DMA).
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes drained.
+ */
+static inline void pow2_ring_buffer_produce(pow2_ring_buffer_t* rb, size_t len)
+{
+	rb->head += len;
+}
+
+/**
+ * @brief Advance write pointer without copying data.
+ *
+ * Used when data is filled directly by hardware (e.g. RX DMA).
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes filled.
+ */
+static inline void pow2_ring_buffer_consume(pow2_ring_buffer_t* rb, size_t len)
+{
+	rb->tail += len;
+}
+
+/**
+ * @brief Number of used bytes readable without crossing the buffer end.
+ *
+ * Equivalent of get_size_to_produce_per_dma_operation() for this ring type.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear readable block starting at head.
+ */
+size_t pow2_ring_buffer_get_linear_used_size(const pow2_ring_buffer_t* rb);
+
+/**
+ * @brief Number of free bytes writable without crossing the buffer end.
+ *
+ * Equivalent of get_size_to_consume_per_dma_operation() for this ring type.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear writable block starting at tail.
+ */
+size_t pow2_ring_buffer_get_linear_free_size(const pow2_ring_buffer_t* rb);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POW2_RING_BUFFER_H__ */
@@ -23,6 +23,10 @@ extern "C" {
  * Tail is advanced by consumer (reader).
  *
  * Buffer is considered full when free space equals zero.
+ *
+ * available_size is modified by both sides, so it is always updated with
+ * an atomic read-modify-write (LDREX/STREX on Cortex-M3). For a ring where
+ * each side owns exactly one index see spsc_ring_buffer_t.
  */
 typedef struct {
     uint8_t* data;          /**< Pointer to raw buffer memory */
@@ -32,6 +36,17 @@ typedef struct {
     size_t   available_size;/**< Cached number of free bytes */
 } ring_buffer_t;
 
+/**
+ * @brief Contiguous block of ring buffer memory.
+ *
+ * Returned by peek/reserve calls. A ring region crossing the end of the
+ * buffer is described by two spans, the second one starting at offset 0.
+ */
+typedef struct {
+    uint8_t* data;          /**< Start of the block inside ring memory */
+    size_t   length;        /**< Block size in bytes, 0 if unused */
+} ring_buffer_span_t;
+
 /**
  * @brief Get number of free bytes available for writing.
  * @param rb Pointer to ring buffer instance.
@@ -105,6 +120,56 @@ void ring_buffer_consume(
     size_t len
 );
 
+/**
+ * @brief Get readable data in place without copying.
+ *
+ * Fills up to two spans covering all pending bytes in order.
+ * Data stays in the buffer until ring_buffer_commit() is called.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param spans Output array of two spans.
+ * @return Total number of readable bytes.
+ */
+size_t ring_buffer_peek(
+    const ring_buffer_t* rb,
+    ring_buffer_span_t spans[2]
+);
+
+/**
+ * @brief Release bytes previously obtained with ring_buffer_peek().
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes processed by the consumer.
+ */
+void ring_buffer_commit(
+    ring_buffer_t* rb,
+    size_t len
+);
+
+/**
+ * @brief Get writable space in place without copying.
+ *
+ * Fills up to two spans covering all free bytes in order.
+ * Written bytes become readable after ring_buffer_publish().
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param spans Output array of two spans.
+ * @return Total number of writable bytes.
+ */
+size_t ring_buffer_reserve(
+    const ring_buffer_t* rb,
+    ring_buffer_span_t spans[2]
+);
+
+/**
+ * @brief Make bytes written into reserved spans readable.
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes written by the producer.
+ */
+void ring_buffer_publish(
+    ring_buffer_t* rb,
+    size_t len
+);
+
 /**
  * @brief Advance read pointer and update free space.
  *
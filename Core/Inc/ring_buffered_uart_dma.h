@@ -11,21 +11,198 @@
 #include <ring_buffer.h>
 #include <dma_ring_buffer.h>
 #include "stm32f1xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <uart_dma_ll.h>
+#include <uart_ports.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#define USART_TX_RING_SIZE 1024
-#define USART_RX_RING_SIZE 1024
+/*
+ * UART_MAX_WAITERS: tasks per port and direction that can sleep in the
+ * blocking calls at once. Further tasks poll once per tick.
+ */
+#ifndef UART_MAX_WAITERS
+#define UART_MAX_WAITERS 4
+#endif
 
+/*
+ * Task notification bits set by the driver (eSetBits). The event task of
+ * uart_dma_set_event_task() gets UART_NOTIFY_EVENT, tasks sleeping in a
+ * blocking call get UART_NOTIFY_WAITER, so the event task may use the
+ * blocking calls without losing events.
+ */
+#define UART_NOTIFY_EVENT   (1u << 0)
+#define UART_NOTIFY_WAITER  (1u << 1)
+
+/*
+ * UART_DMA_BACKEND_LL: 1 programs the DMA channels and USART CR3 directly
+ * (uart_dma_ll.c), 0 goes through HAL_UART_Transmit_DMA() and
+ * HAL_UARTEx_ReceiveToIdle_DMA(). The interrupt handlers in stm32f1xx_it.c
+ * follow the same switch.
+ */
+#ifndef UART_DMA_BACKEND_LL
+#define UART_DMA_BACKEND_LL 0
+#endif
+
+/*
+ * UART_TX_DMA_PINGPONG: 1 prepares the block following the current TX
+ * transfer in advance, the DMA interrupt starts it before any other work.
+ * The line keeps running across ring wraps and transfer boundaries.
+ * Needs the LL backend, HAL cannot chain transfers.
+ */
+#ifndef UART_TX_DMA_PINGPONG
+#define UART_TX_DMA_PINGPONG 0
+#endif
+
+#if UART_TX_DMA_PINGPONG && !UART_DMA_BACKEND_LL
+#error "UART_TX_DMA_PINGPONG requires UART_DMA_BACKEND_LL"
+#endif
+
+/*
+ * UART_DMA_PROFILE: 1 counts DWT cycles spent starting each DMA transfer,
+ * see uart_dma_profile_t.
+ */
+#ifndef UART_DMA_PROFILE
+#define UART_DMA_PROFILE 0
+#endif
+
+/*
+ * UART_RX_STREAM_BUFFER: 1 adds an RX delivery mode where the DMA callbacks
+ * move received data from the RX ring into a FreeRTOS stream buffer of
+ * UART_RX_STREAM_SIZE bytes per port, see uart_rx_set_stream_buffer().
+ */
+#ifndef UART_RX_STREAM_BUFFER
+#define UART_RX_STREAM_BUFFER 0
+#endif
+
+#ifndef UART_RX_STREAM_SIZE
+#define UART_RX_STREAM_SIZE 256
+#endif
+
+#if UART_RX_STREAM_BUFFER
+#include "stream_buffer.h"
+#endif
+
+
+/**
+ * @brief Zero-copy RX to TX forwarding state.
+ *
+ * When enabled, received data is transmitted by TX DMA directly out of
+ * the RX ring and released back to RX only on TX completion.
+ */
+typedef struct {
+    int enabled;            /**< Forward RX data to TX (echo) */
+    size_t in_flight;       /**< RX ring bytes currently owned by TX DMA */
+} uart_dma_forward_t;
+
+/**
+ * @brief Tasks blocked on a UART ring.
+ *
+ * TX waiters are notified from HAL_UART_TxCpltCallback() when ring space
+ * is released, RX waiters from HAL_UARTEx_RxEventCallback() when data
+ * arrives. Every registered task is notified once and its slot is
+ * cleared, a task that still has to wait re-registers.
+ */
+typedef struct {
+    TaskHandle_t tasks[UART_MAX_WAITERS];    /**< Waiting tasks, NULL if slot is free */
+} uart_dma_waiters_t;
+
+/**
+ * @brief TX coalescing policy, see uart_tx_set_coalescing().
+ *
+ * The deadline is a compare channel of a free-running 1 MHz timer.
+ */
+typedef struct {
+    TIM_HandleTypeDef* htim; /**< Deadline timer, 1 MHz, 16-bit period */
+    uint32_t channel;        /**< Compare channel (TIM_CHANNEL_x) owned by this UART */
+    size_t threshold;        /**< Start DMA once this many bytes are queued, 0 disables coalescing */
+    uint16_t timeout_us;     /**< Start DMA this long after the first held byte */
+    int armed;               /**< Deadline pending */
+} uart_tx_coalesce_t;
+
+/**
+ * @brief RX aggregation window, see uart_rx_set_aggregation().
+ *
+ * The window is a compare channel of a free-running 1 MHz timer.
+ */
+typedef struct {
+    TIM_HandleTypeDef* htim; /**< Window timer, 1 MHz, 16-bit period */
+    uint32_t channel;        /**< Compare channel (TIM_CHANNEL_x) owned by this UART */
+    size_t threshold;        /**< Deliver at once when this many bytes are pending */
+    uint16_t timeout_us;     /**< Silence that closes the window, 0 delivers on every RX event */
+    int armed;               /**< Window open, received data is held back */
+} uart_rx_aggregate_t;
+
+/**
+ * @brief Cycle counts of one measured code path.
+ */
+typedef struct {
+    uint32_t count;         /**< Number of samples */
+    uint32_t last;          /**< Last sample, cycles */
+    uint32_t min;           /**< Shortest sample, cycles */
+    uint32_t max;           /**< Longest sample, cycles */
+    uint64_t total;         /**< Sum of all samples, cycles */
+} uart_dma_cycle_stats_t;
+
+/**
+ * @brief Cost of (re)starting DMA on the selected backend.
+ */
+typedef struct {
+    uart_dma_cycle_stats_t tx_restart; /**< TX transfer start, mostly from TxCplt */
+    uart_dma_cycle_stats_t rx_restart; /**< RX transfer start */
+} uart_dma_profile_t;
+
+/**
+ * @brief Per-port traffic counters, updated from DMA callbacks.
+ *
+ * Free-running, sample twice and subtract to get a rate. Error counters
+ * are updated from HAL_UART_ErrorCallback(), one per error class.
+ */
+typedef struct {
+    uint32_t rx_bytes;      /**< Bytes written by RX DMA, including overrun losses */
+    uint32_t rx_events;     /**< RX DMA events (IDLE, half/full transfer) */
+    uint32_t tx_bytes;      /**< Bytes whose TX DMA transfer completed */
+    uint32_t tx_transfers;  /**< Completed TX DMA transfers */
+    uint32_t rx_overrun_errors; /**< USART overruns (ORE), a byte was lost */
+    uint32_t rx_framing_errors; /**< Framing errors (FE) */
+    uint32_t rx_noise_errors;   /**< Noise errors (NE) */
+    uint32_t rx_parity_errors;  /**< Parity errors (PE) */
+    uint32_t rx_dma_restarts;   /**< RX DMA restarts after an error stopped it */
+    uint32_t tx_dma_errors;     /**< TX DMA transfer errors, the block is dropped */
+} uart_dma_port_stats_t;
 
 typedef struct {
     UART_HandleTypeDef* huart;
     dma_producer_ring_t* tx_ring;
     dma_consumer_ring_t* rx_ring;
+    uart_dma_forward_t forward;
+    uart_dma_waiters_t tx_waiters;
+    uart_dma_waiters_t rx_waiters;
+    TaskHandle_t event_task;
+    uart_tx_coalesce_t tx_coalesce;
+    uart_rx_aggregate_t rx_aggregate;
+    uart_dma_port_stats_t stats;
+#if UART_RX_STREAM_BUFFER
+    StreamBufferHandle_t rx_stream;             /**< RX delivery stream, NULL while ring delivery is used */
+    uint8_t* rx_stream_storage;                 /**< UART_RX_STREAM_SIZE + 1 bytes */
+    StaticStreamBuffer_t* rx_stream_static;
+#endif
+#if UART_DMA_PROFILE
+    uart_dma_profile_t profile;
+#endif
 } uart_dma_buffered_instance_t;
 
+/**
+ * @brief One piece of a vectored transmit, see uart_tx_queue_dma_transmitv().
+ */
+typedef struct {
+    const uint8_t* data;    /**< Segment data */
+    size_t length;          /**< Segment length in bytes, may be 0 */
+} uart_tx_segment_t;
+
 typedef enum {
     UART_TX_RESULT_FAILURE = -1,
     UART_TX_RESULT_QUEUED = 0,
@@ -37,7 +214,35 @@ typedef enum {
 } uart_dma_enqueue_rx_result_t;
 
 
-extern UART_HandleTypeDef huart1;
+#define UART_PORT_EXTERN(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) extern UART_HandleTypeDef handle;
+UART_PORTS(UART_PORT_EXTERN)
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
+
+/**
+ * @brief Retrieve the driver instance associated with a UART handle.
+ *
+ * Constant time: the instance is looked up by the USART base address,
+ * so ISR callbacks cost the same however many ports are configured.
+ *
+ * @param huart Pointer to UART handle.
+ * @return Pointer to the instance, or NULL if not found.
+ */
+uart_dma_buffered_instance_t* uart_get_instance(UART_HandleTypeDef* huart);
+
+/**
+ * @brief Apply the UART_PORTS line rate to a UART.
+ *
+ * CubeMX initializes every USART at its .ioc baud rate, call this right
+ * after MX_USARTx_UART_Init() so the rate the rings were sized for at
+ * compile time is the one in use. Also verifies the peripheral clock the
+ * baud accuracy checks assumed.
+ *
+ * @param huart Pointer to UART handle, initialized by CubeMX code.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART, unexpected
+ *         peripheral clock or failed re-initialization.
+ */
+HAL_StatusTypeDef uart_port_apply_config(UART_HandleTypeDef* huart);
 
 /**
  * @brief Retrieve the TX ring buffer associated with a UART instance.
@@ -58,6 +263,8 @@ dma_consumer_ring_t* uart_get_rx_ring(UART_HandleTypeDef* huart);
  * @brief Queue data for transmission via DMA.
  *
  * Copies the data into the TX ring buffer and starts DMA if idle.
+ * Safe to call from several tasks at once: space is reserved atomically
+ * and the call never waits for other writers or for DMA.
  *
  * @param huart Pointer to UART handle.
  * @param data Pointer to source data buffer.
@@ -66,13 +273,100 @@ dma_consumer_ring_t* uart_get_rx_ring(UART_HandleTypeDef* huart);
  */
 uart_dma_enqueue_tx_result_t uart_tx_queue_dma_transmit(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size);
 
+/**
+ * @brief Queue several buffers as one contiguous transmission.
+ *
+ * Space for all segments is reserved in a single step, so the frame is
+ * either queued whole and in order, or rejected with nothing queued.
+ * Writers in other tasks can never interleave with it. DMA is started
+ * at most once per call.
+ *
+ * @param huart Pointer to UART handle.
+ * @param segments Array of segments, sent in array order.
+ * @param count Number of segments.
+ * @return UART_TX_RESULT_QUEUED if successfully queued, UART_TX_RESULT_FAILURE otherwise.
+ */
+uart_dma_enqueue_tx_result_t uart_tx_queue_dma_transmitv(UART_HandleTypeDef* huart, const uart_tx_segment_t* segments, size_t count);
+
+/**
+ * @brief Queue as much data as currently fits in the TX ring.
+ *
+ * Streaming counterpart of uart_tx_queue_dma_transmit(): instead of
+ * failing when the whole message does not fit, the leading part that
+ * fits is queued and the caller continues from the returned offset.
+ * Safe to call from several tasks at once, but pieces written by
+ * different tasks may interleave.
+ *
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @return Number of bytes queued, 0 if the ring is full or the UART is unknown.
+ */
+size_t uart_tx_queue_dma_transmit_partial(UART_HandleTypeDef* huart, const uint8_t* data, size_t size);
+
+/**
+ * @brief Queue all data, blocking while the TX ring is full.
+ *
+ * Data is queued piece by piece as TX DMA drains the ring. While no
+ * space is free the calling task sleeps on its task notification and is
+ * woken from HAL_UART_TxCpltCallback(), so a bulk writer keeps the line
+ * busy without polling. Must be called from a task.
+ *
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of bytes queued, less than @p size on timeout.
+ */
+size_t uart_tx_queue_dma_transmit_blocking(UART_HandleTypeDef* huart, const uint8_t* data, size_t size, uint32_t timeout);
+
+/**
+ * @brief Write all data and wait until it has been transmitted.
+ *
+ * Queues like uart_tx_queue_dma_transmit_blocking(), then sleeps until
+ * TX DMA has released everything reserved up to and including the data.
+ * The task is woken from HAL_UART_TxCpltCallback(), no polling. On the
+ * HAL backend that is the USART transmission complete interrupt. The LL
+ * backend completes at DMA transfer complete, so the call then also
+ * sleeps two character times unless the USART TC flag is already set.
+ * Either way the last stop bit is on the line when HAL_OK is returned:
+ * use it before changing line settings or direction. Must be called
+ * from a task.
+ *
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to write.
+ * @param timeout Maximum time for both in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return HAL_OK once sent, HAL_TIMEOUT if the deadline passed first (part
+ *         of the data may be queued or sent), HAL_ERROR if the UART is unknown.
+ */
+HAL_StatusTypeDef uart_write_all(UART_HandleTypeDef* huart, const uint8_t* data, size_t size, uint32_t timeout);
+
+/**
+ * @brief Configure TX coalescing for a UART.
+ *
+ * With coalescing enabled, writes to an idle channel do not start DMA
+ * right away. DMA is started once @p threshold bytes are queued or
+ * @p timeout_us after the first held byte, whichever comes first, so
+ * many small writes leave in one transfer with one TC interrupt.
+ * Data queued while a transfer is running is sent as soon as it
+ * completes, as before. uart_start_queued_tx_dma_transmit() flushes
+ * held data immediately.
+ *
+ * @param huart Pointer to UART handle.
+ * @param threshold Byte count that starts DMA, 0 to disable coalescing.
+ * @param timeout_us Maximum hold time in microseconds, 1..65535.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART or invalid parameters.
+ */
+HAL_StatusTypeDef uart_tx_set_coalescing(UART_HandleTypeDef* huart, size_t threshold, uint32_t timeout_us);
+
 /**
  * @brief Start DMA transmission of queued TX data.
  *
  * Initiates DMA for remaining data in the TX ring buffer.
  *
  * @param huart Pointer to UART handle.
- * @return HAL_OK if DMA started successfully, HAL_ERROR otherwise.
+ * @return HAL_OK if DMA is running, HAL_ERROR otherwise.
  */
 HAL_StatusTypeDef uart_start_queued_tx_dma_transmit(UART_HandleTypeDef* huart);
 
@@ -88,16 +382,202 @@ HAL_StatusTypeDef uart_start_queued_tx_dma_transmit(UART_HandleTypeDef* huart);
  */
 size_t uart_rx_dma_get_pending_data(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length);
 
+/**
+ * @brief Get pending RX data in place, without copying.
+ *
+ * Fills up to two spans pointing into the RX ring buffer. The data stays
+ * valid until released with uart_rx_dma_commit_pending_data().
+ *
+ * @param huart Pointer to UART handle.
+ * @param spans Output array of two spans.
+ * @return Total number of pending bytes.
+ */
+size_t uart_rx_dma_peek_pending_data(UART_HandleTypeDef* huart, ring_buffer_span_t spans[2]);
+
+/**
+ * @brief Release RX data obtained with uart_rx_dma_peek_pending_data().
+ *
+ * Frees ring space and starts DMA if idle.
+ *
+ * @param huart Pointer to UART handle.
+ * @param length Number of bytes processed.
+ */
+void uart_rx_dma_commit_pending_data(UART_HandleTypeDef* huart, size_t length);
+
+/**
+ * @brief Wait until RX data is pending.
+ *
+ * The calling task sleeps on its task notification and is woken straight
+ * from HAL_UARTEx_RxEventCallback(), no polling. Must be called from a task.
+ * With stream delivery enabled the ring is drained into the stream buffer,
+ * use uart_rx_stream_receive() instead.
+ *
+ * @param huart Pointer to UART handle.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of pending bytes, 0 on timeout, unknown UART or with
+ *         stream delivery enabled.
+ */
+size_t uart_rx_dma_wait_pending_data(UART_HandleTypeDef* huart, uint32_t timeout);
+
+/**
+ * @brief Read received data, blocking until at least one byte arrives.
+ * @param huart Pointer to UART handle.
+ * @param destination Pointer to destination buffer.
+ * @param max_length Maximum number of bytes to read.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of bytes copied, 0 on timeout.
+ */
+size_t uart_rx_dma_receive_blocking(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length, uint32_t timeout);
+
+/**
+ * @brief Read between @p min_length and @p max_length bytes, blocking.
+ *
+ * Returns as soon as at least @p min_length bytes have been read, taking
+ * whatever else is pending up to @p max_length. The task sleeps on its
+ * task notification between RX DMA events, an RX aggregation window
+ * delays the wakeups. Must be called from a task. It does not read the
+ * stream buffer: with stream delivery enabled it returns 0 at once, use
+ * uart_rx_stream_receive() instead.
+ *
+ * @param huart Pointer to UART handle.
+ * @param destination Pointer to destination buffer.
+ * @param min_length Bytes to wait for, 0 does not block.
+ * @param max_length Maximum number of bytes to read.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of bytes copied, less than @p min_length on timeout,
+ *         0 at once with stream delivery enabled.
+ */
+size_t uart_read(UART_HandleTypeDef* huart, uint8_t* destination, size_t min_length, size_t max_length, uint32_t timeout);
+
+/**
+ * @brief Configure the RX aggregation window of a UART.
+ *
+ * The IDLE line interrupt fires after a single idle character, so a
+ * sender pausing briefly between bytes causes many tiny deliveries. With
+ * a window set, readers (RX waiters and the event task) are not woken
+ * on every RX event: each event restarts a @p char_times long window and
+ * data is delivered when it closes, i.e. after that much silence on the
+ * line, or at once when @p threshold bytes are pending.
+ *
+ * 0 @p char_times optimizes for latency (deliver on every event), a few
+ * character times for throughput (fewer, larger deliveries). Data is
+ * always accounted in the ring immediately, peek/get calls see it; only
+ * wakeups are deferred. The window is computed from the current baud rate
+ * and frame format, call again after changing them.
+ *
+ * @param huart Pointer to UART handle.
+ * @param char_times Window length in character times, 0 disables aggregation.
+ * @param threshold Pending byte count that ends the window early, 0 for half the RX ring.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART or a window above 65535 us.
+ */
+HAL_StatusTypeDef uart_rx_set_aggregation(UART_HandleTypeDef* huart, uint32_t char_times, size_t threshold);
+
+/**
+ * @brief Set a task to notify on every RX and TX DMA event of a UART.
+ *
+ * The task gets UART_NOTIFY_EVENT whenever new RX data arrives or a TX
+ * transfer completes. One task can serve several ports: handle all of
+ * them, then uart_dma_wait_event(). Events that happen while it is busy,
+ * in the blocking calls of this driver included, stay pending.
+ *
+ * The task must not wait on its notification with ulTaskNotifyTake() or
+ * block in uart_rx_stream_receive(): both consume a pending event.
+ *
+ * @param huart Pointer to UART handle.
+ * @param task Task to notify, NULL to stop notifications.
+ * @return HAL_OK on success, HAL_ERROR if the UART is unknown.
+ */
+HAL_StatusTypeDef uart_dma_set_event_task(UART_HandleTypeDef* huart, TaskHandle_t task);
+
+/**
+ * @brief Wait for an event on the ports of the calling event task.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Non-zero if an event arrived, 0 on timeout.
+ */
+int uart_dma_wait_event(uint32_t timeout);
+
+#if UART_RX_STREAM_BUFFER
+/**
+ * @brief Deliver RX data of a UART through a FreeRTOS stream buffer.
+ *
+ * Every RX DMA event moves the new data from the RX ring into the port's
+ * stream buffer with xStreamBufferSendFromISR(). A task blocked in
+ * xStreamBufferReceive() wakes once @p trigger_level bytes are buffered
+ * or its timeout expires. Data the stream has no room for stays in the
+ * RX ring until uart_rx_stream_receive() frees space or the next RX event.
+ * One consumer task per port; the RX ring must not be read directly and
+ * forwarding cannot be used at the same time.
+ *
+ * @param huart Pointer to UART handle.
+ * @param trigger_level Bytes that wake the consumer, 1..UART_RX_STREAM_SIZE,
+ *                      0 returns to ring delivery.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART, invalid trigger
+ *         level or forwarding enabled.
+ */
+HAL_StatusTypeDef uart_rx_set_stream_buffer(UART_HandleTypeDef* huart, size_t trigger_level);
+
+/**
+ * @brief Get the RX stream buffer of a UART.
+ * @param huart Pointer to UART handle.
+ * @return Stream buffer handle, NULL if stream delivery is not enabled.
+ */
+StreamBufferHandle_t uart_rx_get_stream_buffer(UART_HandleTypeDef* huart);
+
+/**
+ * @brief Receive from the RX stream buffer, blocking up to @p timeout.
+ *
+ * xStreamBufferReceive() followed by moving data held back in the RX
+ * ring into the freed stream space.
+ *
+ * @param huart Pointer to UART handle.
+ * @param destination Pointer to destination buffer.
+ * @param max_length Maximum number of bytes to read.
+ * @param timeout Maximum time to wait, in ticks.
+ * @return Number of bytes copied, 0 on timeout or without stream delivery.
+ */
+size_t uart_rx_stream_receive(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length, uint32_t timeout);
+#endif
+
+/**
+ * @brief Enable or disable zero-copy RX to TX forwarding (echo).
+ *
+ * While enabled every byte committed to the RX ring by DMA is sent by
+ * TX DMA straight from the RX ring memory, the CPU never copies it.
+ * The RX region is released when its TX transfer completes. Data queued
+ * with uart_tx_queue_dma_transmit() is interleaved between forwarded
+ * chunks. The RX ring must not be read by tasks while forwarding.
+ *
+ * @param huart Pointer to UART handle.
+ * @param enable Non-zero to enable forwarding.
+ * @return HAL_OK on success, HAL_ERROR if the UART is unknown or delivers
+ *         RX data through a stream buffer.
+ */
+HAL_StatusTypeDef uart_rx_dma_set_forward(UART_HandleTypeDef* huart, int enable);
+
 /**
  * @brief Start DMA reception into RX ring buffer.
  *
- * Initiates a DMA transfer to fill the RX ring buffer.
+ * Initiates a DMA transfer to fill the RX ring buffer. If the RX DMA
+ * channel is configured DMA_CIRCULAR, one endless transfer covers the
+ * whole ring and is never re-armed, so no bytes are lost between
+ * transfers. If the reader falls a full ring behind, unread data is
+ * discarded and counted in dma_overrun_count.
  *
  * @param huart Pointer to UART handle.
  * @return HAL_OK if DMA started successfully, HAL_ERROR otherwise.
  */
 HAL_StatusTypeDef uart_start_rx_dma_receive(UART_HandleTypeDef* huart);
 
+#if UART_DMA_PROFILE
+/**
+ * @brief Start the DWT cycle counter and clear DMA restart statistics.
+ *
+ * Build once with each UART_DMA_BACKEND_LL value and compare the
+ * profile field of each instance to see the restart cost of the backends.
+ */
+void uart_dma_profile_reset(void);
+#endif
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,49 @@
+/*
+ * ring_copy.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __RING_COPY_H__
+#define __RING_COPY_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Copies shorter than this are done byte by byte.
+ *
+ * Below this size the alignment prologue costs more than it saves.
+ */
+#define RING_COPY_SMALL_SIZE 8
+
+/**
+ * @brief Copy memory for ring buffer wrap handling.
+ *
+ * Tuned for the small, arbitrarily aligned chunks ring buffers move:
+ *  - destination is aligned to 4 bytes with a byte prologue,
+ *  - when source ends up aligned too, the bulk moves 16 bytes per
+ *    LDM/STM pair on Cortex-M3 (32-bit words on other targets),
+ *  - otherwise the bulk moves 32-bit words with unaligned loads,
+ *  - the remainder is copied byte by byte.
+ *
+ * Regions must not overlap.
+ *
+ * @param dst Destination buffer.
+ * @param src Source buffer.
+ * @param len Number of bytes to copy.
+ */
+void ring_copy(uint8_t* dst, const uint8_t* src, size_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RING_COPY_H__ */
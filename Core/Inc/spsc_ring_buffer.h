@@ -0,0 +1,155 @@
+/*
+ * spsc_ring_buffer.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __SPSC_RING_BUFFER_H__
+#define __SPSC_RING_BUFFER_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pow2_ring_buffer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Static initializer for a lock-free SPSC ring buffer.
+ * @param storage Backing byte array.
+ * @param size Array length, must be a power of two.
+ */
+#define SPSC_RING_BUFFER_INIT(storage, size) \
+	{ .data = (storage), .read_index = 0, .write_index = 0, .mask = (size) - 1 }
+
+/**
+ * @brief Define backing storage and descriptor of a lock-free SPSC ring buffer.
+ *
+ * Fails to compile when @p size is not a power of two.
+ */
+#define SPSC_RING_BUFFER_DEFINE(name, size) \
+	_Static_assert(POW2_RING_BUFFER_IS_VALID_SIZE(size), #name " size must be a power of two"); \
+	uint8_t name##_data[size]; \
+	spsc_ring_buffer_t name = SPSC_RING_BUFFER_INIT(name##_data, size)
+
+
+/**
+ * @brief Lock-free single-producer / single-consumer ring buffer.
+ *
+ * Safe between one ISR and one task (or two threads on the host) without
+ * critical sections. Each side owns exactly one index and only reads the
+ * other one:
+ *  - write_index is stored by the producer only (release),
+ *  - read_index is stored by the consumer only (release),
+ * and each side loads the opposite index with acquire ordering, so data
+ * written before an index update is visible once the index is.
+ *
+ * Indices are free-running and masked into the power-of-two backing array.
+ */
+typedef struct {
+    uint8_t*       data;        /**< Pointer to raw buffer memory */
+    atomic_size_t  read_index;  /**< Free-running read index, owned by consumer */
+    atomic_size_t  write_index; /**< Free-running write index, owned by producer */
+    size_t         mask;        /**< Buffer size in bytes minus one */
+} spsc_ring_buffer_t;
+
+/**
+ * @brief Initialize ring buffer over caller provided storage.
+ * @param rb Pointer to ring buffer instance.
+ * @param storage Backing memory.
+ * @param size Size of backing memory, must be a power of two.
+ * @return 0 on success, -1 if @p size is not a power of two.
+ */
+int spsc_ring_buffer_init(spsc_ring_buffer_t* rb, uint8_t* storage, size_t size);
+
+/**
+ * @brief Get number of bytes readable by the consumer.
+ *
+ * Consumer side call.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of used bytes.
+ */
+size_t spsc_ring_buffer_get_used_size(spsc_ring_buffer_t* rb);
+
+/**
+ * @brief Get number of bytes writable by the producer.
+ *
+ * Producer side call.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of free bytes.
+ */
+size_t spsc_ring_buffer_get_free_size(spsc_ring_buffer_t* rb);
+
+/**
+ * @brief Write data into ring buffer (producer side).
+ *
+ * The write is all or nothing, like ring_buffer_write().
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param src Source data buffer.
+ * @param len Number of bytes to write.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int spsc_ring_buffer_write(spsc_ring_buffer_t* rb, const uint8_t* src, size_t len);
+
+/**
+ * @brief Read data from ring buffer (consumer side).
+ * @param rb Pointer to ring buffer instance.
+ * @param dst Destination buffer.
+ * @param len Maximum number of bytes to read.
+ * @return Number of bytes actually read.
+ */
+size_t spsc_ring_buffer_read(spsc_ring_buffer_t* rb, uint8_t* dst, size_t len);
+
+/**
+ * @brief Number of free bytes writable without crossing the buffer end.
+ *
+ * Producer side call, used to size an RX DMA transfer into the ring.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear writable block starting at write index.
+ */
+size_t spsc_ring_buffer_get_linear_free_size(spsc_ring_buffer_t* rb);
+
+/**
+ * @brief Number of used bytes readable without crossing the buffer end.
+ *
+ * Consumer side call, used to size a TX DMA transfer out of the ring.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear readable block starting at read index.
+ */
+size_t spsc_ring_buffer_get_linear_used_size(spsc_ring_buffer_t* rb);
+
+/**
+ * @brief Publish @p len bytes filled in place (e.g. by RX DMA).
+ *
+ * Producer side call.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes produced.
+ */
+void spsc_ring_buffer_commit_write(spsc_ring_buffer_t* rb, size_t len);
+
+/**
+ * @brief Release @p len bytes drained in place (e.g. by TX DMA).
+ *
+ * Consumer side call.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes consumed.
+ */
+void spsc_ring_buffer_commit_read(spsc_ring_buffer_t* rb, size_t len);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPSC_RING_BUFFER_H__ */
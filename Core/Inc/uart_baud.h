@@ -0,0 +1,102 @@
+/*
+ * uart_baud.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __UART_BAUD_H__
+#define __UART_BAUD_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+ * Baud rate and RX ring sizing arithmetic. Integer constant expressions
+ * only, so the firmware checks its port table with static asserts and
+ * host tools (Tools/ring_bench/baud_calc.c) include this file unchanged.
+ */
+
+/**
+ * @brief Bits on the line per character (start, 8 data, stop).
+ */
+#define UART_BITS_PER_CHAR 10u
+
+/**
+ * @brief Smallest BRR value, 16x oversampling needs a mantissa of 1.
+ */
+#define UART_BRR_MIN 16u
+
+/**
+ * @brief BRR value HAL programs for @p baud, 16x oversampling.
+ *
+ * Same rounding as UART_BRR_SAMPLING16() in stm32f1xx_hal_uart.h.
+ */
+#define UART_BRR_DIV100(pclk, baud)  (((uint64_t)(pclk) * 25u) / (4u * (uint64_t)(baud)))
+#define UART_BRR_VALUE(pclk, baud) \
+	((UART_BRR_DIV100(pclk, baud) / 100u << 4) + \
+	 ((UART_BRR_DIV100(pclk, baud) % 100u) * 16u + 50u) / 100u)
+
+/**
+ * @brief Baud rate actually produced by the programmed BRR.
+ */
+#define UART_BAUD_ACTUAL(pclk, baud) ((uint64_t)(pclk) / UART_BRR_VALUE(pclk, baud))
+
+/**
+ * @brief Deviation of the actual from the requested baud rate, ppm.
+ */
+#define UART_BAUD_ERROR_PPM(pclk, baud) \
+	((UART_BAUD_ACTUAL(pclk, baud) > (uint64_t)(baud) ? \
+	  UART_BAUD_ACTUAL(pclk, baud) - (uint64_t)(baud) : \
+	  (uint64_t)(baud) - UART_BAUD_ACTUAL(pclk, baud)) * 1000000u / (uint64_t)(baud))
+
+/**
+ * @brief Highest baud deviation accepted on our side of the link, ppm.
+ *
+ * The receiver tolerates about 3.75 % of total mismatch at 16x
+ * oversampling, keep at most 1.5 % of it for ourselves.
+ */
+#ifndef UART_BAUD_MAX_ERROR_PPM
+#define UART_BAUD_MAX_ERROR_PPM 15000u
+#endif
+
+/**
+ * @brief Check that @p baud can be generated from @p pclk accurately enough.
+ */
+#define UART_BAUD_IS_VALID(pclk, baud) \
+	((baud) > 0 && (uint64_t)(pclk) >= (uint64_t)(baud) * UART_BRR_MIN && \
+	 UART_BAUD_ERROR_PPM(pclk, baud) <= UART_BAUD_MAX_ERROR_PPM)
+
+/*
+ * Circular RX DMA reports data at half and full ring and on IDLE. In a
+ * continuous stream the reader is woken at each half ring and must have
+ * consumed that half before DMA wraps onto it, i.e. within the time the
+ * other half takes to arrive. Hence:
+ *   ring >= 2 * bytes_per_second * latency
+ * where latency is the worst case from the DMA event to the reader having
+ * committed the data (ISR plus task scheduling plus processing).
+ */
+
+/**
+ * @brief Smallest RX ring that survives @p latency_us at @p baud.
+ */
+#define UART_RX_RING_MIN_SIZE(baud, latency_us) \
+	(2u * (((uint64_t)(baud) * (latency_us) + UART_BITS_PER_CHAR * 1000000u - 1) / \
+	       (UART_BITS_PER_CHAR * 1000000u)))
+
+/**
+ * @brief Longest reader latency an RX ring of @p rx_size tolerates at @p baud, us.
+ */
+#define UART_RX_LATENCY_LIMIT_US(baud, rx_size) \
+	((uint64_t)(rx_size) * UART_BITS_PER_CHAR * 1000000u / (2u * (uint64_t)(baud)))
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_BAUD_H__ */
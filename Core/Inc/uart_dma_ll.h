@@ -0,0 +1,135 @@
+/*
+ * uart_dma_ll.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __UART_DMA_LL_H__
+#define __UART_DMA_LL_H__
+
+#include "stm32f1xx_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+ * Register level replacement for HAL_UART_Transmit_DMA() and
+ * HAL_UARTEx_ReceiveToIdle_DMA().
+ *
+ * The channels keep the configuration written by HAL_DMA_Init() in
+ * HAL_UART_MspInit() (direction, increment, width, normal/circular mode),
+ * only addresses, length and enable bits are touched per transfer. No HAL
+ * state, lock or callback registration is involved. Completion is reported
+ * through the same HAL_UART_TxCpltCallback() / HAL_UARTEx_RxEventCallback()
+ * as with HAL, so the ring driver does not change.
+ *
+ * The DMA and USART interrupt handlers must call the uart_dma_ll_*_irq_handler()
+ * functions instead of the HAL handlers for the UART using this backend.
+ */
+
+/**
+ * @brief Start a memory to USART DMA transfer.
+ *
+ * HAL_UART_TxCpltCallback() is called from the DMA transfer complete
+ * interrupt, when the buffer has been read, while the last bytes may
+ * still be shifting out.
+ *
+ * @param huart Pointer to UART handle with linked TX DMA handle.
+ * @param data Source buffer.
+ * @param size Number of bytes, non-zero.
+ * @return HAL_OK if started, HAL_ERROR on invalid size.
+ */
+HAL_StatusTypeDef uart_dma_ll_transmit(UART_HandleTypeDef* huart, const uint8_t* data, uint16_t size);
+
+/**
+ * @brief Arm the block to transmit right after the current one (ping-pong).
+ *
+ * On transfer complete the interrupt handler programs this block before
+ * anything else, while the USART still shifts out the last two bytes,
+ * and only then calls HAL_UART_TxCpltCallback(). Must be armed before
+ * the transfer it follows is started, or from HAL_UART_TxCpltCallback().
+ *
+ * @param huart Pointer to UART handle with linked TX DMA handle.
+ * @param data Source buffer.
+ * @param size Number of bytes, 0 to disarm.
+ */
+void uart_dma_ll_set_next(UART_HandleTypeDef* huart, const uint8_t* data, uint16_t size);
+
+/**
+ * @brief Get and clear the size of the block chained at the last TC.
+ *
+ * Called from HAL_UART_TxCpltCallback() to learn whether the armed
+ * block is already being transmitted.
+ *
+ * @param huart Pointer to UART handle with linked TX DMA handle.
+ * @return Size of the chained block, 0 if the channel stopped.
+ */
+uint16_t uart_dma_ll_take_chained(UART_HandleTypeDef* huart);
+
+/**
+ * @brief Check whether the USART has shifted out the last transmitted byte.
+ *
+ * Reads the USART TC flag, which every transfer started here clears.
+ * Lets a caller woken by the DMA completion wait for the last two bytes.
+ *
+ * @param huart Pointer to UART handle.
+ * @return Non-zero once the line is idle.
+ */
+int uart_dma_ll_tx_is_idle(UART_HandleTypeDef* huart);
+
+/**
+ * @brief Start USART to memory DMA reception with IDLE line detection.
+ *
+ * HAL_UARTEx_RxEventCallback() is called on half transfer, transfer
+ * complete and IDLE with the number of bytes received in this transfer.
+ * Unlike HAL, a normal mode transfer is not stopped on IDLE.
+ *
+ * @param huart Pointer to UART handle with linked RX DMA handle.
+ * @param data Destination buffer.
+ * @param size Buffer size in bytes, non-zero.
+ * @return HAL_OK if started, HAL_ERROR on invalid size.
+ */
+HAL_StatusTypeDef uart_dma_ll_receive_to_idle(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size);
+
+/**
+ * @brief Check whether the RX DMA channel still has room to receive.
+ * @param huart Pointer to UART handle.
+ * @return Non-zero if the channel is enabled and not exhausted.
+ */
+int uart_dma_ll_rx_is_active(UART_HandleTypeDef* huart);
+
+/**
+ * @brief TX DMA channel interrupt handler.
+ * @param huart Pointer to UART handle owning the channel.
+ */
+void uart_dma_ll_tx_irq_handler(UART_HandleTypeDef* huart);
+
+/**
+ * @brief RX DMA channel interrupt handler.
+ *
+ * A transfer error stops the channel and is reported through
+ * HAL_UART_ErrorCallback() with HAL_UART_ERROR_DMA set.
+ *
+ * @param huart Pointer to UART handle owning the channel.
+ */
+void uart_dma_ll_rx_irq_handler(UART_HandleTypeDef* huart);
+
+/**
+ * @brief USART interrupt handler (IDLE line detection, reception errors).
+ *
+ * Errors are reported through HAL_UART_ErrorCallback() with huart->ErrorCode
+ * set, RX DMA keeps running.
+ *
+ * @param huart Pointer to UART handle.
+ */
+void uart_dma_ll_usart_irq_handler(UART_HandleTypeDef* huart);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_DMA_LL_H__ */
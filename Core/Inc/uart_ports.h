@@ -0,0 +1,129 @@
+/*
+ * uart_ports.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __UART_PORTS_H__
+#define __UART_PORTS_H__
+
+#include <uart_baud.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Default ring sizes, used by the table below.
+ */
+#ifndef USART_TX_RING_SIZE
+#define USART_TX_RING_SIZE 1024
+#endif
+#ifndef USART_RX_RING_SIZE
+#define USART_RX_RING_SIZE 1024
+#endif
+
+/*
+ * UART_HIGH_SPEED_PROFILE: 1 runs USART1 at UART_HIGH_SPEED_BAUD
+ * (921600 by default, up to 4.5 Mbaud from PCLK2 = 72 MHz) instead of
+ * 19200. The build fails if the rate cannot be generated accurately or
+ * the RX ring cannot absorb UART_RX_LATENCY_BUDGET_US at that rate.
+ */
+#ifndef UART_HIGH_SPEED_PROFILE
+#define UART_HIGH_SPEED_PROFILE 0
+#endif
+
+#ifndef UART_HIGH_SPEED_BAUD
+#define UART_HIGH_SPEED_BAUD 921600u
+#endif
+
+/**
+ * @brief Line rate of each port.
+ */
+#ifndef UART1_BAUD
+#if UART_HIGH_SPEED_PROFILE
+#define UART1_BAUD UART_HIGH_SPEED_BAUD
+#else
+#define UART1_BAUD 19200u
+#endif
+#endif
+#ifndef UART2_BAUD
+#define UART2_BAUD 19200u
+#endif
+#ifndef UART3_BAUD
+#define UART3_BAUD 19200u
+#endif
+
+/**
+ * @brief Worst case from an RX DMA event to the reader committing its data, us.
+ *
+ * Covers interrupt latency, waking the reader task and its processing.
+ * Every port's RX ring is checked against it at compile time.
+ */
+#ifndef UART_RX_LATENCY_BUDGET_US
+#define UART_RX_LATENCY_BUDGET_US 1000u
+#endif
+
+/**
+ * @brief Peripheral clocks set up by SystemClock_Config(), checked at runtime.
+ */
+#define UART_PCLK1_HZ 36000000u
+#define UART_PCLK2_HZ 72000000u
+
+/**
+ * @brief Clock of a USART: USART1 sits on APB2, the others on APB1.
+ */
+#define UART_PCLK_OF(base) ((base) >= APB2PERIPH_BASE ? UART_PCLK2_HZ : UART_PCLK1_HZ)
+
+/**
+ * @brief Ports served by the buffered UART DMA driver.
+ *
+ * One X(name, handle, usart, baud, tx_size, rx_size, tim_channel,
+ * rx_tim_channel) entry per port. The driver expands the table into ring
+ * storage, ring descriptors, instances and the lookup table, nothing else
+ * has to be declared by hand.
+ *  - name:             prefix of the generated objects (name_tx_ring, ...),
+ *  - handle:           CubeMX UART handle, defined in usart.c,
+ *  - usart:            USART peripheral of the handle,
+ *  - baud:             line rate, applied by uart_port_apply_config(),
+ *  - tx_size:          TX ring bytes, power of two up to 16384,
+ *  - rx_size:          RX ring bytes, 1..65535 (one DMA transfer) and at
+ *                      least UART_RX_RING_MIN_SIZE(baud, UART_RX_LATENCY_BUDGET_US),
+ *  - tim_channel:      TIM2 compare channel for TX coalescing, one per port,
+ *  - rx_tim_channel:   TIM3 compare channel for the RX aggregation window,
+ *                      one per port.
+ *
+ * Define UART_PORTS before including this file to replace the table.
+ */
+#ifndef UART_PORTS
+#define UART_PORTS(X) \
+	X(uart1, huart1, USART1, UART1_BAUD, USART_TX_RING_SIZE, USART_RX_RING_SIZE, TIM_CHANNEL_1, TIM_CHANNEL_1) \
+	X(uart2, huart2, USART2, UART2_BAUD, USART_TX_RING_SIZE, USART_RX_RING_SIZE, TIM_CHANNEL_2, TIM_CHANNEL_2) \
+	X(uart3, huart3, USART3, UART3_BAUD, USART_TX_RING_SIZE, USART_RX_RING_SIZE, TIM_CHANNEL_3, TIM_CHANNEL_3)
+#endif
+
+/**
+ * @brief SRAM allowed for all UART rings together, checked at compile time.
+ */
+#ifndef UART_PORTS_RAM_BUDGET
+#define UART_PORTS_RAM_BUDGET (12u * 1024u)
+#endif
+
+#define UART_PORT_ENUM(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) UART_PORT_##name,
+
+/**
+ * @brief Index of each port in uart_instances[].
+ */
+enum {
+	UART_PORTS(UART_PORT_ENUM)
+	UART_PORT_COUNT
+};
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_PORTS_H__ */
@@ -0,0 +1,147 @@
+/*
+ * uart_trace.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#ifndef __UART_TRACE_H__
+#define __UART_TRACE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+ * UART_TRACE: 1 records driver events with a DWT cycle timestamp into the
+ * RAM trace buffer uart_trace: DMA starts and completions, RX events, ring
+ * index updates and DMA channel ownership changes. A record is one atomic
+ * index increment and two word stores. The buffer wraps, the newest
+ * UART_TRACE_SIZE records are kept.
+ */
+#ifndef UART_TRACE
+#define UART_TRACE 0
+#endif
+
+/*
+ * UART_TRACE_SIZE: records in the trace buffer, power of two, 8 bytes each.
+ */
+#ifndef UART_TRACE_SIZE
+#define UART_TRACE_SIZE 256
+#endif
+
+/**
+ * @brief Traced events, argument in parentheses.
+ */
+typedef enum {
+	UART_TRACE_TX_START = 1,    /**< TX DMA transfer started (length) */
+	UART_TRACE_TX_TC,           /**< TX DMA transfer complete (length) */
+	UART_TRACE_TX_BUSY,         /**< TX dma_busy changed (new value) */
+	UART_TRACE_TX_HEAD,         /**< TX ring read index after a release (index) */
+	UART_TRACE_TX_TAIL,         /**< TX ring commit index after an enqueue (index) */
+	UART_TRACE_RX_START,        /**< RX DMA transfer started (length) */
+	UART_TRACE_RX_HT,           /**< RX half transfer event (new bytes) */
+	UART_TRACE_RX_TC,           /**< RX transfer complete event (new bytes) */
+	UART_TRACE_RX_IDLE,         /**< RX IDLE line event (new bytes) */
+	UART_TRACE_RX_BUSY,         /**< RX dma_busy changed (new value) */
+	UART_TRACE_RX_HEAD,         /**< RX ring head after the reader freed space (index) */
+	UART_TRACE_RX_TAIL,         /**< RX ring tail after DMA data was accounted (index) */
+	UART_TRACE_RX_ERROR,        /**< USART error (HAL_UART_ERROR_xx bits) */
+} uart_trace_event_t;
+
+/**
+ * @brief One trace record.
+ */
+typedef struct {
+	uint32_t time;          /**< DWT cycle count */
+	uint32_t info;          /**< Bits 0-7 event, 8-15 port index, 16-31 argument */
+} uart_trace_record_t;
+
+/*
+ * Dump format: the uart_trace object as it is in RAM, little-endian:
+ *
+ *   header    u32 magic, u8 version, u8 port count P, u16 reserved,
+ *             u32 CPU clock in Hz, u32 record count N, u32 records written
+ *   port      P x { 8 bytes name (NUL padded), u32 baud rate }
+ *   records   N x uart_trace_record_t, the oldest at records written % N
+ *             once the buffer has wrapped
+ *
+ * Tools/ring_bench/uart_trace_decode.c turns it into a timeline.
+ */
+#define UART_TRACE_MAGIC            0x43525455u     /* "UTRC" */
+#define UART_TRACE_VERSION          1u
+#define UART_TRACE_HEADER_SIZE      20u
+#define UART_TRACE_PORT_SIZE        12u
+#define UART_TRACE_PORT_NAME_SIZE   8u
+
+#if UART_TRACE
+#include "main.h"
+#include <uart_ports.h>
+
+_Static_assert((UART_TRACE_SIZE & (UART_TRACE_SIZE - 1)) == 0 && UART_TRACE_SIZE <= 65536,
+		"UART_TRACE_SIZE must be a power of two");
+
+typedef struct {
+	char name[UART_TRACE_PORT_NAME_SIZE];
+	uint32_t baud;
+} uart_trace_port_t;
+
+/**
+ * @brief Trace buffer, dump sizeof(uart_trace) bytes from its address.
+ */
+typedef struct {
+	uint32_t magic;
+	uint8_t version;
+	uint8_t port_count;
+	uint16_t reserved;
+	uint32_t cpu_hz;
+	uint32_t size;
+	uint32_t written;       /**< Records written, free-running */
+	uart_trace_port_t ports[UART_PORT_COUNT];
+	uart_trace_record_t records[UART_TRACE_SIZE];
+	int enabled;            /**< Not part of the dump */
+} uart_trace_t;
+
+extern uart_trace_t uart_trace;
+
+/**
+ * @brief Append one record.
+ * @param event Event.
+ * @param port Port index in UART_PORTS.
+ * @param arg Event argument, truncated to 16 bits.
+ */
+static inline void uart_trace_record(uart_trace_event_t event, uint32_t port, uint32_t arg)
+{
+	if (!uart_trace.enabled)
+		return;
+
+	uint32_t i = __atomic_fetch_add(&uart_trace.written, 1, __ATOMIC_RELAXED) & (UART_TRACE_SIZE - 1);
+	uart_trace.records[i].time = DWT->CYCCNT;
+	uart_trace.records[i].info = (uint32_t)event | port << 8 | arg << 16;
+}
+
+/**
+ * @brief Clear the trace buffer and start recording.
+ *
+ * Enables the DWT cycle counter.
+ */
+void uart_trace_start(void);
+
+/**
+ * @brief Stop recording, the buffer can be dumped afterwards.
+ * @param size Receives the dump size in bytes, may be NULL.
+ * @return Start of the dump.
+ */
+const uint8_t* uart_trace_stop(size_t* size);
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,251 @@
+/*
+ * cpu_profile.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include <cpu_profile.h>
+
+#if CPU_PROFILE
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+typedef struct {
+	const void* task;       // NULL: slot free
+	char name[configMAX_TASK_NAME_LEN];
+	uint64_t cycles;
+	uint32_t switches;
+} cpu_profile_task_t;
+
+typedef struct {
+	uint64_t cycles;
+	uint32_t count;
+	uint32_t max;
+} cpu_profile_irq_t;
+
+#define CPU_PROFILE_IRQ_NAME(name) #name,
+static const char* const cpu_profile_irq_names[CPU_PROFILE_IRQ_COUNT] = { CPU_PROFILE_IRQS(CPU_PROFILE_IRQ_NAME) };
+
+static cpu_profile_task_t cpu_profile_tasks[CPU_PROFILE_MAX_TASKS];
+static cpu_profile_irq_t cpu_profile_irqs[CPU_PROFILE_IRQ_COUNT];
+static uint32_t cpu_profile_untracked_switches;
+
+// Running task and what the counters showed when it was switched in
+static cpu_profile_task_t* cpu_profile_current;
+static uint32_t cpu_profile_switched_in_at;
+static uint64_t cpu_profile_irq_cycles_at;
+
+// All handler cycles, subtracted from the interrupted task
+static uint64_t cpu_profile_irq_cycles;
+
+/**
+ * @brief Enable the DWT cycle counter.
+ *
+ * Called by the scheduler as portCONFIGURE_TIMER_FOR_RUN_TIME_STATS().
+ */
+void cpu_profile_init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Current DWT cycle count, portGET_RUN_TIME_COUNTER_VALUE().
+ * @return Free-running cycle count.
+ */
+uint32_t cpu_profile_cycles(void)
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief Find or assign the statistics slot of a task.
+ * @param task Task handle.
+ * @return Slot, NULL if the table is full.
+ */
+static cpu_profile_task_t* cpu_profile_task_slot(const void* task)
+{
+	for (size_t i = 0; i < CPU_PROFILE_MAX_TASKS; i++) {
+		cpu_profile_task_t* t = &cpu_profile_tasks[i];
+		if (t->task == task)
+			return t;
+		if (t->task == NULL) {
+			t->task = task;
+			strncpy(t->name, pcTaskGetName((TaskHandle_t)task), sizeof(t->name));
+			return t;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Charge the running task with its cycles since it was switched in
+ * or last accounted, less the handler cycles in between.
+ * @param now Current cycle count.
+ */
+static void cpu_profile_account(uint32_t now)
+{
+	if (cpu_profile_current != NULL)
+		cpu_profile_current->cycles += (uint32_t)(now - cpu_profile_switched_in_at)
+				- (uint32_t)(cpu_profile_irq_cycles - cpu_profile_irq_cycles_at);
+	cpu_profile_switched_in_at = now;
+	cpu_profile_irq_cycles_at = cpu_profile_irq_cycles;
+}
+
+/**
+ * @brief Account the task being switched out, traceTASK_SWITCHED_OUT().
+ * @param task Handle of the running task.
+ */
+void cpu_profile_task_switched_out(const void* task)
+{
+	(void)task;
+	cpu_profile_account(DWT->CYCCNT);
+}
+
+/**
+ * @brief Start accounting the task switched in, traceTASK_SWITCHED_IN().
+ * @param task Handle of the task selected to run.
+ */
+void cpu_profile_task_switched_in(const void* task)
+{
+	cpu_profile_task_t* t = cpu_profile_task_slot(task);
+
+	// vTaskSwitchContext() often selects the task that was running
+	if (t == NULL)
+		cpu_profile_untracked_switches++;
+	else if (t != cpu_profile_current)
+		t->switches++;
+	cpu_profile_current = t;
+	cpu_profile_switched_in_at = DWT->CYCCNT;
+	cpu_profile_irq_cycles_at = cpu_profile_irq_cycles;
+}
+
+/**
+ * @brief Read the counters at handler entry.
+ * @return Mark to pass to cpu_profile_irq_exit().
+ */
+cpu_profile_irq_mark_t cpu_profile_irq_enter(void)
+{
+	cpu_profile_irq_mark_t mark = {
+		.start = DWT->CYCCNT,
+		.irq_cycles = (uint32_t)cpu_profile_irq_cycles,
+	};
+	return mark;
+}
+
+/**
+ * @brief Account one run of an interrupt handler, less the handlers that
+ * preempted it.
+ * @param id Handler.
+ * @param mark Counters at handler entry.
+ */
+void cpu_profile_irq_exit(cpu_profile_irq_id_t id, cpu_profile_irq_mark_t mark)
+{
+	cpu_profile_irq_t* irq = &cpu_profile_irqs[id];
+
+	// TIM1_UP can be preempted by the other handlers
+	UBaseType_t saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+	uint32_t cycles = (DWT->CYCCNT - mark.start) - ((uint32_t)cpu_profile_irq_cycles - mark.irq_cycles);
+
+	irq->cycles += cycles;
+	irq->count++;
+	if (cycles > irq->max)
+		irq->max = cycles;
+	cpu_profile_irq_cycles += cycles;
+	taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+}
+
+/**
+ * @brief Clear all task and interrupt statistics.
+ */
+void cpu_profile_reset(void)
+{
+	taskENTER_CRITICAL();
+	for (size_t i = 0; i < CPU_PROFILE_MAX_TASKS; i++) {
+		cpu_profile_tasks[i].cycles = 0;
+		cpu_profile_tasks[i].switches = 0;
+	}
+	memset(cpu_profile_irqs, 0, sizeof(cpu_profile_irqs));
+	cpu_profile_untracked_switches = 0;
+	cpu_profile_switched_in_at = DWT->CYCCNT;
+	cpu_profile_irq_cycles_at = cpu_profile_irq_cycles;
+	taskEXIT_CRITICAL();
+}
+
+static uint8_t* cpu_profile_put_u32(uint8_t* p, uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+		*p++ = (uint8_t)(value >> (8 * i));
+	return p;
+}
+
+static uint8_t* cpu_profile_put_u64(uint8_t* p, uint64_t value)
+{
+	p = cpu_profile_put_u32(p, (uint32_t)value);
+	return cpu_profile_put_u32(p, (uint32_t)(value >> 32));
+}
+
+static uint8_t* cpu_profile_put_name(uint8_t* p, const char* name)
+{
+	strncpy((char*)p, name, configMAX_TASK_NAME_LEN);
+	return p + configMAX_TASK_NAME_LEN;
+}
+
+/**
+ * @brief Write a snapshot of the statistics in the binary format above.
+ *
+ * Call from a task; the calling task is accounted up to the call.
+ *
+ * @param buffer Destination.
+ * @param size Destination size in bytes.
+ * @return Snapshot length, 0 if it does not fit.
+ */
+size_t cpu_profile_snapshot(uint8_t* buffer, size_t size)
+{
+	uint8_t* p = buffer;
+	size_t tasks = 0;
+
+	taskENTER_CRITICAL();
+	while (tasks < CPU_PROFILE_MAX_TASKS && cpu_profile_tasks[tasks].task != NULL)
+		tasks++;
+
+	size_t length = CPU_PROFILE_HEADER_SIZE + tasks * CPU_PROFILE_TASK_SIZE(configMAX_TASK_NAME_LEN)
+			+ CPU_PROFILE_IRQ_COUNT * CPU_PROFILE_IRQ_SIZE(configMAX_TASK_NAME_LEN);
+	if (length > size) {
+		taskEXIT_CRITICAL();
+		return 0;
+	}
+
+	cpu_profile_account(DWT->CYCCNT);
+
+	p = cpu_profile_put_u32(p, CPU_PROFILE_MAGIC);
+	*p++ = CPU_PROFILE_VERSION;
+	*p++ = configMAX_TASK_NAME_LEN;
+	*p++ = (uint8_t)tasks;
+	*p++ = CPU_PROFILE_IRQ_COUNT;
+	p = cpu_profile_put_u32(p, SystemCoreClock);
+	p = cpu_profile_put_u32(p, configTICK_RATE_HZ);
+	p = cpu_profile_put_u32(p, xTaskGetTickCount());
+	p = cpu_profile_put_u32(p, cpu_profile_untracked_switches);
+
+	for (size_t i = 0; i < tasks; i++) {
+		cpu_profile_task_t* t = &cpu_profile_tasks[i];
+		p = cpu_profile_put_name(p, t->name);
+		p = cpu_profile_put_u64(p, t->cycles);
+		p = cpu_profile_put_u32(p, t->switches);
+	}
+	for (size_t i = 0; i < CPU_PROFILE_IRQ_COUNT; i++) {
+		cpu_profile_irq_t* irq = &cpu_profile_irqs[i];
+		p = cpu_profile_put_name(p, cpu_profile_irq_names[i]);
+		p = cpu_profile_put_u64(p, irq->cycles);
+		p = cpu_profile_put_u32(p, irq->count);
+		p = cpu_profile_put_u32(p, irq->max);
+	}
+	taskEXIT_CRITICAL();
+
+	return (size_t)(p - buffer);
+}
+#endif
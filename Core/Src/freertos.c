@@ -27,6 +27,7 @@
 /* USER CODE BEGIN Includes */
 #include "usart.h"
 #include <ring_buffered_uart_dma.h>
+#include <uart_trace.h>
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -36,6 +37,11 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+// 1: echo by forwarding RX ring blocks straight to TX DMA (no CPU copy)
+// 0: echo through the task, copying RX data into the TX ring
+#ifndef ECHO_DMA_FORWARD
+#define ECHO_DMA_FORWARD 0
+#endif
 
 /* USER CODE END PD */
 
@@ -46,6 +52,10 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
+// Every port in UART_PORTS echoes independently
+#define ECHO_PORT(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) &handle,
+static UART_HandleTypeDef* const echo_ports[] = { UART_PORTS(ECHO_PORT) };
+#define ECHO_PORT_COUNT UART_PORT_COUNT
 
 /* USER CODE END Variables */
 osThreadId defaultTaskHandle;
@@ -64,6 +74,32 @@ void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 /* GetIdleTaskMemory prototype (linked to static allocation support) */
 void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 
+/* Pre/Post sleep processing prototypes */
+void PreSleepProcessing(uint32_t *ulExpectedIdleTime);
+void PostSleepProcessing(uint32_t *ulExpectedIdleTime);
+
+/* USER CODE BEGIN PREPOSTSLEEP */
+// Tickless idle sleeps in Sleep mode (WFI), not Stop: USART and DMA stay
+// clocked, RX DMA keeps filling the ring while the core sleeps and the USART
+// IDLE, DMA HT/TC and TX complete interrupts end the sleep. In Stop mode the
+// USART has no clock and the character that wakes the core is lost.
+void PreSleepProcessing(uint32_t *ulExpectedIdleTime)
+{
+  (void)ulExpectedIdleTime;
+
+  // The TIM1 HAL timebase would end every sleep after 1 ms. HAL_GetTick()
+  // stands still while asleep; the driver uses no HAL call with a timeout.
+  HAL_SuspendTick();
+}
+
+void PostSleepProcessing(uint32_t *ulExpectedIdleTime)
+{
+  (void)ulExpectedIdleTime;
+
+  HAL_ResumeTick();
+}
+/* USER CODE END PREPOSTSLEEP */
+
 /* USER CODE BEGIN GET_IDLE_TASK_MEMORY */
 static StaticTask_t xIdleTaskTCBBuffer;
 static StackType_t xIdleStack[configMINIMAL_STACK_SIZE];
@@ -84,6 +120,10 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
   */
 void MX_FREERTOS_Init(void) {
   /* USER CODE BEGIN Init */
+  // Flash interface clock off in Sleep mode, SRAM clock kept on:
+  // RX and TX DMA access the rings while the core sleeps
+  __HAL_RCC_FLITF_CLK_DISABLE();
+  __HAL_RCC_SRAM_CLK_ENABLE();
 
   /* USER CODE END Init */
 
@@ -133,26 +173,62 @@ void MX_FREERTOS_Init(void) {
 void StartDefaultTask(void const * argument)
 {
   /* USER CODE BEGIN StartDefaultTask */
-    const size_t BUF_SIZE = 256;
-    uint8_t buffer[BUF_SIZE];
-
-    // Start RX DMA once at the beginning
-    uart_start_rx_dma_receive(&huart1);
+#if UART_DMA_PROFILE
+    uart_dma_profile_reset();
+#endif
+#if UART_TRACE
+    uart_trace_start();
+#endif
+
+#if ECHO_DMA_FORWARD
+    // Echo is handled entirely by DMA callbacks
+    for (size_t p = 0; p < ECHO_PORT_COUNT; p++) {
+        uart_rx_dma_set_forward(echo_ports[p], 1);
+        uart_start_rx_dma_receive(echo_ports[p]);
+    }
 
     for(;;)
     {
-        // Read any pending RX data
-        int received_size = uart_rx_dma_get_pending_data(&huart1, buffer, BUF_SIZE);
+        osDelay(osWaitForever);
+    }
+#else
+    ring_buffer_span_t spans[2];
+
+    // Get woken by RX data and TX completions of every port,
+    // then start RX DMA once at the beginning
+    for (size_t p = 0; p < ECHO_PORT_COUNT; p++) {
+        uart_dma_set_event_task(echo_ports[p], xTaskGetCurrentTaskHandle());
+        uart_start_rx_dma_receive(echo_ports[p]);
+    }
 
-        if (received_size > 0)
+    for(;;)
+    {
+        for (size_t p = 0; p < ECHO_PORT_COUNT; p++)
         {
-            // Queue data for TX DMA
-            uart_tx_queue_dma_transmit(&huart1, buffer, received_size);
+            UART_HandleTypeDef* huart = echo_ports[p];
+
+            // Look at pending RX data in place, no intermediate copy
+            size_t received_size = uart_rx_dma_peek_pending_data(huart, spans);
+            if (received_size == 0)
+                continue;
+
+            // Queue data for TX DMA straight from the RX ring,
+            // release only what the TX ring accepted
+            size_t queued_size = 0;
+            for (int i = 0; i < 2 && spans[i].length != 0; i++) {
+                size_t span_queued = uart_tx_queue_dma_transmit_partial(huart, spans[i].data, spans[i].length);
+                queued_size += span_queued;
+                if (span_queued != spans[i].length)
+                    break;
+            }
+            uart_rx_dma_commit_pending_data(huart, queued_size);
         }
 
-        // Optional: yield to other tasks to prevent busy looping
-        osDelay(1); // 1 ms delay, FreeRTOS friendly
+        // Sleep until the next DMA event, events raised while the ports
+        // were being served stay pending
+        uart_dma_wait_event(HAL_MAX_DELAY);
     }
+#endif
   /* USER CODE END StartDefaultTask */
 }
 
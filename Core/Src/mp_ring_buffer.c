@@ -0,0 +1,218 @@
+/*
+ * mp_ring_buffer.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include "mp_ring_buffer.h"
+#include "ring_copy.h"
+
+#define MP_RING_INDEX_MASK    0xFFFFu
+#define MP_RING_WRITERS_SHIFT 16
+#define MP_RING_WRITER_ONE    (1u << MP_RING_WRITERS_SHIFT)
+
+
+/**
+ * @brief Initialize ring buffer over caller provided storage.
+ * @param rb Pointer to ring buffer instance.
+ * @param storage Backing memory.
+ * @param size Size of backing memory, see MP_RING_BUFFER_IS_VALID_SIZE().
+ * @return 0 on success, -1 if @p size is invalid.
+ */
+int mp_ring_buffer_init(mp_ring_buffer_t* rb, uint8_t* storage, size_t size)
+{
+	if (!MP_RING_BUFFER_IS_VALID_SIZE(size))
+		return -1;
+
+	rb->data = storage;
+	rb->mask = size - 1;
+	atomic_init(&rb->reserve_state, 0);
+	atomic_init(&rb->commit_index, 0);
+	atomic_init(&rb->read_index, 0);
+	return 0;
+}
+
+/**
+ * @brief Get number of bytes not yet reserved by any producer.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of free bytes.
+ */
+size_t mp_ring_buffer_get_free_size(mp_ring_buffer_t* rb)
+{
+	uint32_t state = atomic_load_explicit(&rb->reserve_state, memory_order_relaxed);
+	uint32_t read_index = atomic_load_explicit(&rb->read_index, memory_order_acquire);
+	uint32_t used = (state - read_index) & MP_RING_INDEX_MASK;
+	return mp_ring_buffer_get_length(rb) - used;
+}
+
+/**
+ * @brief Claim up to @p max_len bytes, at least @p min_len.
+ * @return Number of bytes reserved, 0 on failure.
+ */
+static size_t mp_ring_buffer_claim(mp_ring_buffer_t* rb, size_t min_len, size_t max_len, uint32_t* start)
+{
+	uint32_t state = atomic_load_explicit(&rb->reserve_state, memory_order_relaxed);
+	uint32_t desired;
+	size_t len;
+
+	do {
+		// Space freed by the consumer must be observed before reusing it
+		uint32_t read_index = atomic_load_explicit(&rb->read_index, memory_order_acquire);
+		size_t free_size = mp_ring_buffer_get_length(rb) - ((state - read_index) & MP_RING_INDEX_MASK);
+
+		len = max_len < free_size ? max_len : free_size;
+		if (len == 0 || len < min_len)
+			return 0;
+
+		desired = ((state + len) & MP_RING_INDEX_MASK) | ((state & ~MP_RING_INDEX_MASK) + MP_RING_WRITER_ONE);
+	} while (!atomic_compare_exchange_weak_explicit(&rb->reserve_state, &state, desired,
+			memory_order_acquire, memory_order_relaxed));
+
+	*start = state & MP_RING_INDEX_MASK;
+	return len;
+}
+
+/**
+ * @brief Atomically reserve @p len bytes for writing (producer side).
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes to reserve, 0 < len <= ring size.
+ * @param start Receives the index of the first reserved byte.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int mp_ring_buffer_reserve(mp_ring_buffer_t* rb, size_t len, uint32_t* start)
+{
+	if (len == 0)
+		return -1;
+	return mp_ring_buffer_claim(rb, len, len, start) == len ? 0 : -1;
+}
+
+/**
+ * @brief Reserve as many bytes as currently free, up to @p max_len.
+ * @param rb Pointer to ring buffer instance.
+ * @param max_len Maximum number of bytes to reserve.
+ * @param start Receives the index of the first reserved byte.
+ * @return Number of bytes reserved, 0 if the ring is full.
+ */
+size_t mp_ring_buffer_reserve_partial(mp_ring_buffer_t* rb, size_t max_len, uint32_t* start)
+{
+	return mp_ring_buffer_claim(rb, 1, max_len, start);
+}
+
+/**
+ * @brief Copy data into reserved space, handling the wrap.
+ * @param rb Pointer to ring buffer instance.
+ * @param index Ring index to write at (inside a reservation).
+ * @param src Source data buffer.
+ * @param len Number of bytes to copy.
+ */
+void mp_ring_buffer_copy_in(mp_ring_buffer_t* rb, uint32_t index, const uint8_t* src, size_t len)
+{
+	size_t offset = index & rb->mask;
+	size_t size_till_ring_wrap = mp_ring_buffer_get_length(rb) - offset;
+	size_t size_to_append_after_tail = len >= size_till_ring_wrap ? size_till_ring_wrap : len;
+
+	// Copy data until the end of buffer, then wrap around if needed
+	ring_copy(rb->data + offset, src, size_to_append_after_tail);
+	ring_copy(rb->data, src + size_to_append_after_tail, len - size_to_append_after_tail);
+}
+
+/**
+ * @brief Finish a reservation made with mp_ring_buffer_reserve().
+ * @param rb Pointer to ring buffer instance.
+ */
+void mp_ring_buffer_commit(mp_ring_buffer_t* rb)
+{
+	// Release: this writer's data is complete before it stops being counted
+	uint32_t state = atomic_fetch_sub_explicit(&rb->reserve_state, MP_RING_WRITER_ONE,
+			memory_order_acq_rel) - MP_RING_WRITER_ONE;
+
+	if ((state >> MP_RING_WRITERS_SHIFT) != 0)
+		return;
+
+	// No writer is active: everything reserved up to this index is written.
+	// A later publisher may already have gone further, never move back.
+	uint32_t target = state & MP_RING_INDEX_MASK;
+	uint32_t current = atomic_load_explicit(&rb->commit_index, memory_order_relaxed);
+	while ((int16_t)(target - current) > 0) {
+		if (atomic_compare_exchange_weak_explicit(&rb->commit_index, &current, target,
+				memory_order_release, memory_order_relaxed))
+			break;
+	}
+}
+
+/**
+ * @brief Reserve, copy and commit in one call.
+ * @param rb Pointer to ring buffer instance.
+ * @param src Source data buffer.
+ * @param len Number of bytes to write.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int mp_ring_buffer_write(mp_ring_buffer_t* rb, const uint8_t* src, size_t len)
+{
+	uint32_t start;
+
+	if (len == 0)
+		return 0;
+	if (mp_ring_buffer_reserve(rb, len, &start) != 0)
+		return -1;
+
+	mp_ring_buffer_copy_in(rb, start, src, len);
+	mp_ring_buffer_commit(rb);
+	return 0;
+}
+
+/**
+ * @brief Get number of committed bytes readable by the consumer.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of readable bytes.
+ */
+size_t mp_ring_buffer_get_used_size(mp_ring_buffer_t* rb)
+{
+	uint32_t commit_index = atomic_load_explicit(&rb->commit_index, memory_order_acquire);
+	uint32_t read_index = atomic_load_explicit(&rb->read_index, memory_order_relaxed);
+	return (commit_index - read_index) & MP_RING_INDEX_MASK;
+}
+
+/**
+ * @brief Get the linear committed block at the read position (consumer side).
+ * @param rb Pointer to ring buffer instance.
+ * @param data Receives pointer to the first readable byte.
+ * @return Size of the block, 0 if nothing is committed.
+ */
+size_t mp_ring_buffer_peek_linear(mp_ring_buffer_t* rb, uint8_t** data)
+{
+	return mp_ring_buffer_peek_linear_at(rb, 0, data);
+}
+
+/**
+ * @brief Get the linear committed block @p offset bytes past the read position.
+ * @param rb Pointer to ring buffer instance.
+ * @param offset Distance from the read position in bytes.
+ * @param data Receives pointer to the first byte of the block.
+ * @return Size of the block, 0 if nothing is committed past @p offset.
+ */
+size_t mp_ring_buffer_peek_linear_at(mp_ring_buffer_t* rb, size_t offset, uint8_t** data)
+{
+	size_t used = mp_ring_buffer_get_used_size(rb);
+	size_t position = (atomic_load_explicit(&rb->read_index, memory_order_relaxed) + offset) & rb->mask;
+	size_t size_till_ring_wrap = mp_ring_buffer_get_length(rb) - position;
+
+	*data = rb->data + position;
+	if (offset >= used)
+		return 0;
+
+	used -= offset;
+	return used < size_till_ring_wrap ? used : size_till_ring_wrap;
+}
+
+/**
+ * @brief Release @p len bytes after the consumer is done with them.
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes consumed.
+ */
+void mp_ring_buffer_release(mp_ring_buffer_t* rb, size_t len)
+{
+	uint32_t read_index = atomic_load_explicit(&rb->read_index, memory_order_relaxed);
+	atomic_store_explicit(&rb->read_index, (read_index + len) & MP_RING_INDEX_MASK, memory_order_release);
+}
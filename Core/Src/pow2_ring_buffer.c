@@ -0,0 +1,122 @@
+/*
+ * pow2_ring_buffer.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include "pow2_ring_buffer.h"
+#include <string.h>
+
+
+/**
+ * @brief Initialize ring buffer over caller provided storage.
+ * @param rb Pointer to ring buffer instance.
+ * @param storage Backing memory.
+ * @param size Size of backing memory, must be a power of two.
+ * @return 0 on success, -1 if @p size is not a power of two.
+ */
+int pow2_ring_buffer_init(pow2_ring_buffer_t* rb, uint8_t* storage, size_t size)
+{
+	if (!POW2_RING_BUFFER_IS_VALID_SIZE(size))
+		return -1;
+
+	rb->data = storage;
+	rb->head = 0;
+	rb->tail = 0;
+	rb->mask = size - 1;
+	return 0;
+}
+
+/**
+ * @brief Write data into ring buffer and advance write pointer.
+ *
+ * Same contract as ring_buffer_write(): the write is all or nothing.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param src Source data buffer.
+ * @param len Number of bytes to write.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int pow2_ring_buffer_write(
+    pow2_ring_buffer_t* rb,
+    const uint8_t* src,
+    size_t len
+)
+{
+	if (len == 0)
+		return 0;
+	if (len > pow2_ring_buffer_get_free_size(rb))
+		return -1;
+
+	size_t offset = rb->tail & rb->mask;
+	size_t size_till_ring_wrap = pow2_ring_buffer_get_length(rb) - offset;
+	size_t size_to_append_after_tail = len >= size_till_ring_wrap ? size_till_ring_wrap : len;
+
+	// Copy data until the end of buffer, then wrap around if needed
+	memcpy(rb->data + offset, src, size_to_append_after_tail);
+	memcpy(rb->data, src + size_to_append_after_tail, len - size_to_append_after_tail);
+
+	rb->tail += len;
+	return 0;
+}
+
+/**
+ * @brief Read data from ring buffer and advance read pointer.
+ *
+ * Copies up to @p len bytes from buffer into destination.
+ * Actual number of bytes read may be smaller if buffer is empty.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param dst Destination buffer.
+ * @param len Number of bytes to read.
+ * @return Number of bytes actually read.
+ */
+size_t pow2_ring_buffer_read(
+    pow2_ring_buffer_t* rb,
+    uint8_t* dst,
+    size_t len
+)
+{
+	size_t pending_size = pow2_ring_buffer_get_used_size(rb);
+
+	if (len == 0 || pending_size == 0)
+		return 0;
+	if (len > pending_size)
+		len = pending_size;
+
+	size_t offset = rb->head & rb->mask;
+	size_t size_till_ring_wrap = pow2_ring_buffer_get_length(rb) - offset;
+	size_t size_to_copy_till_ring_wrap = len > size_till_ring_wrap ? size_till_ring_wrap : len;
+
+	// Copy data until end of buffer, then wrap around if necessary
+	memcpy(dst, rb->data + offset, size_to_copy_till_ring_wrap);
+	memcpy(dst + size_to_copy_till_ring_wrap, rb->data, len - size_to_copy_till_ring_wrap);
+
+	rb->head += len;
+	return len;
+}
+
+/**
+ * @brief Number of used bytes readable without crossing the buffer end.
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear readable block starting at head.
+ */
+size_t pow2_ring_buffer_get_linear_used_size(const pow2_ring_buffer_t* rb)
+{
+	size_t used = pow2_ring_buffer_get_used_size(rb);
+	size_t size_till_ring_wrap = pow2_ring_buffer_get_length(rb) - (rb->head & rb->mask);
+	return used < size_till_ring_wrap ? used : size_till_ring_wrap;
+}
+
+/**
+ * @brief Number of free bytes writable without crossing the buffer end.
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear writable block starting at tail.
+ */
+size_t pow2_ring_buffer_get_linear_free_size(const pow2_ring_buffer_t* rb)
+{
+	size_t free_size = pow2_ring_buffer_get_free_size(rb);
+	size_t size_till_ring_wrap = pow2_ring_buffer_get_length(rb) - (rb->tail & rb->mask);
+	return free_size < size_till_ring_wrap ? free_size : size_till_ring_wrap;
+}
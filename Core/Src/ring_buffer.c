@@ -6,7 +6,7 @@
  */
 
 #include "ring_buffer.h"
-#include <string.h>
+#include "ring_copy.h"
 
 
 /**
@@ -16,7 +16,7 @@
  */
 size_t ring_buffer_get_free_size(const ring_buffer_t* rb)
 {
-	return rb->available_size;
+	return __atomic_load_n(&rb->available_size, __ATOMIC_ACQUIRE);
 }
 
 /**
@@ -26,7 +26,7 @@ size_t ring_buffer_get_free_size(const ring_buffer_t* rb)
  */
 size_t ring_buffer_get_used_size(const ring_buffer_t* rb)
 {
-	return rb->length - rb->available_size;
+	return rb->length - __atomic_load_n(&rb->available_size, __ATOMIC_ACQUIRE);
 }
 
 /**
@@ -55,8 +55,8 @@ int ring_buffer_write(
 	int size_to_append_after_tail = len >= size_till_ring_wrap ? size_till_ring_wrap : len;
 
 	// Copy data until the end of buffer, then wrap around if needed
-	memcpy(rb->data + rb->tail, src, size_to_append_after_tail);
-	memcpy(rb->data, src + size_to_append_after_tail, len - size_to_append_after_tail);
+	ring_copy(rb->data + rb->tail, src, size_to_append_after_tail);
+	ring_copy(rb->data, src + size_to_append_after_tail, len - size_to_append_after_tail);
 
 	ring_buffer_alloc_space(rb, len);
 	return 0;
@@ -107,8 +107,8 @@ size_t ring_buffer_read(
 	size_t size_to_copy_till_ring_wrap = len > size_till_ring_wrap ? size_till_ring_wrap : len;
 
 	// Copy data until end of buffer, then wrap around if necessary
-	memcpy(dst, rb->data + rb->head, size_to_copy_till_ring_wrap);
-	memcpy(dst + size_to_copy_till_ring_wrap, rb->data, len - size_to_copy_till_ring_wrap);
+	ring_copy(dst, rb->data + rb->head, size_to_copy_till_ring_wrap);
+	ring_copy(dst + size_to_copy_till_ring_wrap, rb->data, len - size_to_copy_till_ring_wrap);
 
 	ring_buffer_free_space(rb, len);
 	return len;
@@ -130,6 +130,91 @@ void ring_buffer_consume(
 	ring_buffer_alloc_space(rb, len);
 }
 
+/**
+ * @brief Split @p len bytes starting at @p offset into two spans.
+ */
+static void ring_buffer_fill_spans(
+    const ring_buffer_t* rb,
+    size_t offset,
+    size_t len,
+    ring_buffer_span_t spans[2]
+)
+{
+	size_t size_till_ring_wrap = rb->length - offset;
+	size_t first_size = len > size_till_ring_wrap ? size_till_ring_wrap : len;
+
+	spans[0].data = rb->data + offset;
+	spans[0].length = first_size;
+	spans[1].data = rb->data;
+	spans[1].length = len - first_size;
+}
+
+/**
+ * @brief Get readable data in place without copying.
+ *
+ * Fills up to two spans covering all pending bytes in order.
+ * Data stays in the buffer until ring_buffer_commit() is called.
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param spans Output array of two spans.
+ * @return Total number of readable bytes.
+ */
+size_t ring_buffer_peek(
+    const ring_buffer_t* rb,
+    ring_buffer_span_t spans[2]
+)
+{
+	size_t pending_size = ring_buffer_get_used_size(rb);
+	ring_buffer_fill_spans(rb, rb->head, pending_size, spans);
+	return pending_size;
+}
+
+/**
+ * @brief Release bytes previously obtained with ring_buffer_peek().
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes processed by the consumer.
+ */
+void ring_buffer_commit(
+    ring_buffer_t* rb,
+    size_t len
+)
+{
+	ring_buffer_free_space(rb, len);
+}
+
+/**
+ * @brief Get writable space in place without copying.
+ *
+ * Fills up to two spans covering all free bytes in order.
+ * Written bytes become readable after ring_buffer_publish().
+ *
+ * @param rb Pointer to ring buffer instance.
+ * @param spans Output array of two spans.
+ * @return Total number of writable bytes.
+ */
+size_t ring_buffer_reserve(
+    const ring_buffer_t* rb,
+    ring_buffer_span_t spans[2]
+)
+{
+	size_t free_size = ring_buffer_get_free_size(rb);
+	ring_buffer_fill_spans(rb, rb->tail, free_size, spans);
+	return free_size;
+}
+
+/**
+ * @brief Make bytes written into reserved spans readable.
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes written by the producer.
+ */
+void ring_buffer_publish(
+    ring_buffer_t* rb,
+    size_t len
+)
+{
+	ring_buffer_alloc_space(rb, len);
+}
+
 
 /**
  * @brief Allocate space in ring buffer by advancing read pointer.
@@ -145,7 +230,8 @@ void ring_buffer_consume(
 void ring_buffer_alloc_space(ring_buffer_t* rb, size_t size)
 {
     rb->tail = (rb->tail + size) % rb->length;
-    rb->available_size -= size;
+    // Counter is shared with the other side (ISR vs task), update atomically
+    __atomic_fetch_sub(&rb->available_size, size, __ATOMIC_RELEASE);
 }
 
 /**
@@ -163,5 +249,5 @@ void ring_buffer_alloc_space(ring_buffer_t* rb, size_t size)
 void ring_buffer_free_space(ring_buffer_t* rb, size_t size)
 {
     rb->head = (rb->head + size) % rb->length;
-    rb->available_size += size;
+    __atomic_fetch_add(&rb->available_size, size, __ATOMIC_RELEASE);
 }
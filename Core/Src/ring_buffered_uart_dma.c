@@ -8,189 +8,1724 @@
 #include <ring_buffered_uart_dma.h>
 #include <ring_buffer.h>
 #include <dma_ring_buffer.h>
+#include <uart_trace.h>
 #include <string.h>
 #include <stdint.h>
 
-uint8_t uart1_tx_ring_buffer_data[USART_TX_RING_SIZE];
-uint8_t uart1_rx_ring_buffer_data[USART_RX_RING_SIZE];
+// Ring storage and descriptors of every port in UART_PORTS
+#define UART_PORT_DEFINE_RINGS(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	_Static_assert((rx_size) > 0 && (rx_size) <= 0xFFFFu, #name " RX ring must be 1..65535 bytes"); \
+	_Static_assert(UART_BAUD_IS_VALID(UART_PCLK_OF(usart##_BASE), baud), \
+			#name " baud rate cannot be generated within UART_BAUD_MAX_ERROR_PPM"); \
+	_Static_assert((rx_size) >= UART_RX_RING_MIN_SIZE(baud, UART_RX_LATENCY_BUDGET_US), \
+			#name " RX ring too small for its baud rate and UART_RX_LATENCY_BUDGET_US"); \
+	uint8_t name##_rx_ring_buffer_data[rx_size]; \
+	MP_RING_BUFFER_DEFINE(name##_tx_ring_buffer, tx_size); \
+	ring_buffer_t name##_rx_ring_buffer = { \
+		.data = name##_rx_ring_buffer_data, \
+		.available_size = (rx_size), \
+		.length = (rx_size), \
+		.head = 0, \
+		.tail = 0, \
+	}; \
+	dma_producer_ring_t name##_tx_ring = { \
+		.ring_buffer = &name##_tx_ring_buffer, \
+		.dma_last_size = 0, \
+		.dma_busy = 0, \
+		.released_total = 0, \
+	}; \
+	dma_consumer_ring_t name##_rx_ring = { \
+		.ring_buffer = &name##_rx_ring_buffer, \
+		.dma_last_size = 0, \
+		.dma_busy = 0, \
+		.dma_circular = 0, \
+		.dma_position = 0, \
+		.dma_overrun = 0, \
+		.dma_overrun_count = 0, \
+		.dma_circular_resume = 0, \
+	};
 
-ring_buffer_t uart1_tx_ring_buffer = {
-	.data = uart1_tx_ring_buffer_data,
-	.available_size = USART_TX_RING_SIZE,
-	.length = USART_TX_RING_SIZE,
-	.head = 0,
-	.tail = 0,
+UART_PORTS(UART_PORT_DEFINE_RINGS)
+
+#if UART_RX_STREAM_BUFFER
+#define UART_PORT_DEFINE_STREAM(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	static uint8_t name##_rx_stream_storage[UART_RX_STREAM_SIZE + 1]; \
+	static StaticStreamBuffer_t name##_rx_stream_static;
+
+UART_PORTS(UART_PORT_DEFINE_STREAM)
+
+#define UART_PORT_STREAM_BYTES (UART_RX_STREAM_SIZE + 1)
+#define UART_PORT_STREAM_INIT(name) \
+		.rx_stream_storage = name##_rx_stream_storage, \
+		.rx_stream_static = &name##_rx_stream_static,
+#else
+#define UART_PORT_STREAM_BYTES 0
+#define UART_PORT_STREAM_INIT(name)
+#endif
+
+#define UART_PORT_RING_BYTES(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	+ (tx_size) + (rx_size) + UART_PORT_STREAM_BYTES
+
+_Static_assert((0 UART_PORTS(UART_PORT_RING_BYTES)) <= UART_PORTS_RAM_BUDGET,
+		"UART rings exceed UART_PORTS_RAM_BUDGET");
+
+#define UART_PORT_INSTANCE(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	[UART_PORT_##name] = { \
+		.huart = &handle, \
+		.tx_ring = &name##_tx_ring, \
+		.rx_ring = &name##_rx_ring, \
+		.tx_coalesce = { .htim = &htim2, .channel = (tim_channel) }, \
+		.rx_aggregate = { .htim = &htim3, .channel = (rx_tim_channel) }, \
+		UART_PORT_STREAM_INIT(name) \
+	},
+
+uart_dma_buffered_instance_t uart_instances[UART_PORT_COUNT] = {
+	UART_PORTS(UART_PORT_INSTANCE)
+};
+
+#define UART_PORT_BAUD(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	[UART_PORT_##name] = (baud),
+
+static const uint32_t uart_port_baud[UART_PORT_COUNT] = {
+	UART_PORTS(UART_PORT_BAUD)
+};
+
+// USART register blocks sit on distinct 1 KiB pages of the peripheral bus,
+// address bits 10-12 pick a unique slot per port without scanning
+#define UART_SLOT_COUNT           8u
+#define UART_SLOT_OF(base)        ((((uintptr_t)(base)) >> 10) & (UART_SLOT_COUNT - 1))
+
+_Static_assert(UART_SLOT_OF(USART1_BASE) != UART_SLOT_OF(USART2_BASE) &&
+		UART_SLOT_OF(USART1_BASE) != UART_SLOT_OF(USART3_BASE) &&
+		UART_SLOT_OF(USART2_BASE) != UART_SLOT_OF(USART3_BASE),
+		"USART base addresses must map to distinct slots");
+
+#define UART_PORT_SLOT(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	[UART_SLOT_OF(usart##_BASE)] = &uart_instances[UART_PORT_##name],
+
+static uart_dma_buffered_instance_t* const uart_instance_slots[UART_SLOT_COUNT] = {
+	UART_PORTS(UART_PORT_SLOT)
 };
 
-ring_buffer_t uart1_rx_ring_buffer = {
-	.data = uart1_rx_ring_buffer_data,
-	.available_size = USART_RX_RING_SIZE,
-	.length = USART_RX_RING_SIZE,
-	.head = 0,
-	.tail = 0,
-};
+// Compare channel (TIM_CHANNEL_x >> 2) of the coalescing and aggregation
+// timers to the port it serves, so the timer interrupt finds the port
+// without scanning
+#define UART_DEADLINE_CHANNELS    4u
+
+#define UART_PORT_TX_DEADLINE(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	[(tim_channel) >> 2] = &uart_instances[UART_PORT_##name],
+#define UART_PORT_RX_DEADLINE(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	[(rx_tim_channel) >> 2] = &uart_instances[UART_PORT_##name],
+
+static uart_dma_buffered_instance_t* const uart_tx_deadline_ports[UART_DEADLINE_CHANNELS] = {
+	UART_PORTS(UART_PORT_TX_DEADLINE)
+};
+
+static uart_dma_buffered_instance_t* const uart_rx_deadline_ports[UART_DEADLINE_CHANNELS] = {
+	UART_PORTS(UART_PORT_RX_DEADLINE)
+};
+
+static HAL_StatusTypeDef uart_start_forward_tx_dma_transmit(uart_dma_buffered_instance_t* inst);
+static int uart_tx_dma_claim(uart_dma_buffered_instance_t* inst);
+static HAL_StatusTypeDef uart_tx_dma_run(uart_dma_buffered_instance_t* inst);
+static void uart_tx_dma_kick(uart_dma_buffered_instance_t* inst);
+static void uart_tx_dma_request(uart_dma_buffered_instance_t* inst);
+static int uart_rx_dma_resync(uart_dma_buffered_instance_t* inst);
+static int uart_rx_dma_discard_overrun(uart_dma_buffered_instance_t* inst);
+static HAL_StatusTypeDef uart_start_rx_dma_circular_receive(UART_HandleTypeDef* huart, dma_consumer_ring_t* r);
+static void uart_rx_aggregate_disarm(uart_rx_aggregate_t* a);
+static int uart_rx_aggregate_hold(uart_dma_buffered_instance_t* inst);
+static void uart_rx_deliver_from_isr(uart_dma_buffered_instance_t* inst);
+static size_t uart_rx_dma_normal_update(UART_HandleTypeDef* huart, dma_consumer_ring_t* r, uint16_t size_to_receive_completed);
+static void uart_rx_dma_set_circular(UART_HandleTypeDef* huart, int enable);
+#if UART_RX_STREAM_BUFFER
+static void uart_rx_stream_flush_from_isr(uart_dma_buffered_instance_t* inst, StreamBufferHandle_t stream);
+static void uart_rx_stream_flush(uart_dma_buffered_instance_t* inst, StreamBufferHandle_t stream);
+#endif
+#if UART_TX_DMA_PINGPONG
+static void uart_tx_dma_prepare_next(uart_dma_buffered_instance_t* inst, size_t offset);
+#endif
+
+#if UART_DMA_PROFILE
+#define UART_DMA_PROFILE_BEGIN()    uint32_t profile_start = DWT->CYCCNT
+#define UART_DMA_PROFILE_END(stats) uart_dma_profile_add((stats), DWT->CYCCNT - profile_start)
+
+/**
+ * @brief Add one sample to cycle statistics.
+ * @param stats Pointer to statistics.
+ * @param cycles Measured cycles.
+ */
+static void uart_dma_profile_add(uart_dma_cycle_stats_t* stats, uint32_t cycles)
+{
+	if (stats->count == 0 || cycles < stats->min)
+		stats->min = cycles;
+	if (cycles > stats->max)
+		stats->max = cycles;
+	stats->last = cycles;
+	stats->total += cycles;
+	stats->count++;
+}
+#else
+#define UART_DMA_PROFILE_BEGIN()
+#define UART_DMA_PROFILE_END(stats)
+#endif
+
+#if UART_TRACE
+#define UART_TRACE_EVENT(event, inst, arg) \
+	uart_trace_record(UART_TRACE_##event, (uint32_t)((inst) - uart_instances), (arg))
+#else
+#define UART_TRACE_EVENT(event, inst, arg) do { } while (0)
+#endif
+
+/**
+ * @brief Start a TX DMA transfer on the selected backend.
+ * @param inst Pointer to driver instance.
+ * @param data Source buffer.
+ * @param size Number of bytes.
+ * @return HAL_OK if DMA started.
+ */
+static inline HAL_StatusTypeDef uart_dma_transmit(uart_dma_buffered_instance_t* inst, uint8_t* data, size_t size)
+{
+	UART_DMA_PROFILE_BEGIN();
+#if UART_DMA_BACKEND_LL
+	HAL_StatusTypeDef hal_result = uart_dma_ll_transmit(inst->huart, data, size);
+#else
+	HAL_StatusTypeDef hal_result = HAL_UART_Transmit_DMA(inst->huart, data, size);
+#endif
+	UART_DMA_PROFILE_END(&inst->profile.tx_restart);
+	if (hal_result == HAL_OK)
+		UART_TRACE_EVENT(TX_START, inst, size);
+	return hal_result;
+}
+
+/**
+ * @brief Start an RX DMA transfer with IDLE detection on the selected backend.
+ * @param huart Pointer to UART handle.
+ * @param data Destination buffer.
+ * @param size Buffer size in bytes.
+ * @return HAL_OK if DMA started.
+ */
+static inline HAL_StatusTypeDef uart_dma_receive_to_idle(UART_HandleTypeDef* huart, uint8_t* data, size_t size)
+{
+#if UART_DMA_PROFILE
+	// Look up outside of the measured window
+	uart_dma_cycle_stats_t* rx_restart_stats = &uart_get_instance(huart)->profile.rx_restart;
+#endif
+	UART_DMA_PROFILE_BEGIN();
+#if UART_DMA_BACKEND_LL
+	HAL_StatusTypeDef hal_result = uart_dma_ll_receive_to_idle(huart, data, size);
+#else
+	HAL_StatusTypeDef hal_result = HAL_UARTEx_ReceiveToIdle_DMA(huart, data, size);
+#endif
+	UART_DMA_PROFILE_END(rx_restart_stats);
+	if (hal_result == HAL_OK)
+		UART_TRACE_EVENT(RX_START, uart_get_instance(huart), size);
+	return hal_result;
+}
+
+/**
+ * @brief Check whether the RX DMA transfer is still running.
+ * @param huart Pointer to UART handle.
+ * @return Non-zero if DMA can still receive into the current block.
+ */
+static inline int uart_dma_rx_is_active(UART_HandleTypeDef* huart)
+{
+#if UART_DMA_BACKEND_LL
+	return uart_dma_ll_rx_is_active(huart);
+#else
+	return HAL_DMA_GetState(huart->hdmarx) == HAL_DMA_STATE_BUSY;
+#endif
+}
+
+/**
+ * @brief Set RX DMA channel ownership.
+ * @param huart Pointer to UART handle.
+ * @param r Pointer to RX ring.
+ * @param busy Non-zero while an RX transfer is programmed.
+ */
+static inline void uart_rx_dma_set_busy(UART_HandleTypeDef* huart, dma_consumer_ring_t* r, int busy)
+{
+#if UART_TRACE
+	if (r->dma_busy != busy)
+		UART_TRACE_EVENT(RX_BUSY, uart_get_instance(huart), busy);
+#else
+	(void)huart;
+#endif
+	r->dma_busy = busy;
+}
+
+static size_t uart_tx_enqueue_partial(uart_dma_buffered_instance_t* inst, const uint8_t* data, size_t size);
+static size_t uart_tx_enqueue_blocking(uart_dma_buffered_instance_t* inst, const uint8_t* data, size_t size,
+		TimeOut_t* time_out, TickType_t* ticks_to_wait);
+
+
+/**
+ * @brief Retrieve the driver instance associated with a UART handle.
+ * @param huart Pointer to UART handle.
+ * @return Pointer to the instance, or NULL if not found.
+ */
+uart_dma_buffered_instance_t* uart_get_instance(UART_HandleTypeDef* huart)
+{
+	// Constant time from the USART base address, independent of port count.
+	// The handle check rejects a second handle bound to the same USART.
+	uart_dma_buffered_instance_t* inst = uart_instance_slots[UART_SLOT_OF(huart->Instance)];
+	return inst != NULL && inst->huart == huart ? inst : NULL;
+}
+
+/**
+ * @brief Retrieve the TX ring buffer associated with a UART instance.
+ * @param huart Pointer to UART handle.
+ * @return Pointer to the TX ring buffer, or NULL if not found.
+ */
+dma_producer_ring_t* uart_get_tx_ring(UART_HandleTypeDef* huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	return inst ? inst->tx_ring : NULL;
+}
+
+/**
+ * @brief Retrieve the RX ring buffer associated with a UART instance.
+ * @param huart Pointer to UART handle.
+ * @return Pointer to the RX ring buffer, or NULL if not found.
+ */
+dma_consumer_ring_t* uart_get_rx_ring(UART_HandleTypeDef* huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	return inst ? inst->rx_ring : NULL;
+}
+
+/**
+ * @brief Apply the UART_PORTS line rate to a UART.
+ * @param huart Pointer to UART handle, initialized by CubeMX code.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART, unexpected
+ *         peripheral clock or failed re-initialization.
+ */
+HAL_StatusTypeDef uart_port_apply_config(UART_HandleTypeDef* huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+
+	// Baud accuracy was checked at compile time against these clocks
+	uint32_t pclk = huart->Instance == USART1 ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+	if (pclk != UART_PCLK_OF((uintptr_t)huart->Instance))
+		return HAL_ERROR;
+
+	uint32_t baud = uart_port_baud[inst - uart_instances];
+	if (huart->Init.BaudRate == baud)
+		return HAL_OK;
+
+	huart->Init.BaudRate = baud;
+	return HAL_UART_Init(huart);
+}
+
+/**
+ * @brief Queue data for transmission via DMA.
+ *
+ * Copies the data into the TX ring buffer and starts DMA if idle.
+ * Safe to call from several tasks at once: space is reserved atomically
+ * and the call never waits for other writers or for DMA.
+ *
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @return UART_TX_RESULT_QUEUED if successfully queued, UART_TX_RESULT_FAILURE otherwise.
+ */
+uart_dma_enqueue_tx_result_t uart_tx_queue_dma_transmit(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return UART_TX_RESULT_FAILURE;
+
+	if (size == 0)
+		return UART_TX_RESULT_FAILURE;
+
+	if (mp_ring_buffer_write(inst->tx_ring->ring_buffer, data, size) != 0)
+		return UART_TX_RESULT_FAILURE;
+
+	// Start DMA if not already busy, or hold it per coalescing policy
+	uart_tx_dma_request(inst);
+
+	return UART_TX_RESULT_QUEUED;
+}
+
+/**
+ * @brief Queue several buffers as one contiguous transmission.
+ * @param huart Pointer to UART handle.
+ * @param segments Array of segments, sent in array order.
+ * @param count Number of segments.
+ * @return UART_TX_RESULT_QUEUED if successfully queued, UART_TX_RESULT_FAILURE otherwise.
+ */
+uart_dma_enqueue_tx_result_t uart_tx_queue_dma_transmitv(UART_HandleTypeDef* huart, const uart_tx_segment_t* segments, size_t count)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return UART_TX_RESULT_FAILURE;
+
+	mp_ring_buffer_t* rb = inst->tx_ring->ring_buffer;
+	size_t total_size = 0;
+	uint32_t start;
+
+	for (size_t i = 0; i < count; i++)
+		total_size += segments[i].length;
+
+	if (total_size == 0)
+		return UART_TX_RESULT_FAILURE;
+
+	// One reservation for the whole frame: all or nothing
+	if (mp_ring_buffer_reserve(rb, total_size, &start) != 0)
+		return UART_TX_RESULT_FAILURE;
+
+	for (size_t i = 0; i < count; i++) {
+		mp_ring_buffer_copy_in(rb, start, segments[i].data, segments[i].length);
+		start += segments[i].length;
+	}
+	mp_ring_buffer_commit(rb);
+	UART_TRACE_EVENT(TX_TAIL, inst, atomic_load_explicit(&rb->commit_index, memory_order_relaxed));
+
+	uart_tx_dma_request(inst);
+
+	return UART_TX_RESULT_QUEUED;
+}
+
+/**
+ * @brief Queue as much data as currently fits in the TX ring.
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @return Number of bytes queued, 0 if the ring is full or the UART is unknown.
+ */
+size_t uart_tx_queue_dma_transmit_partial(UART_HandleTypeDef* huart, const uint8_t* data, size_t size)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return 0;
+
+	return uart_tx_enqueue_partial(inst, data, size);
+}
+
+/**
+ * @brief Register a task to be notified on the next ring event.
+ * @param w Pointer to waiter list.
+ * @param task Task to register.
+ * @return Non-zero if registered, 0 if all slots are taken.
+ */
+static int uart_waiters_add(uart_dma_waiters_t* w, TaskHandle_t task)
+{
+	int added = 0;
+
+	taskENTER_CRITICAL();
+	for (size_t i = 0; i < UART_MAX_WAITERS; i++) {
+		if (w->tasks[i] == NULL) {
+			w->tasks[i] = task;
+			added = 1;
+			break;
+		}
+	}
+	taskEXIT_CRITICAL();
+	return added;
+}
+
+/**
+ * @brief Unregister a task, no-op if it was already notified.
+ * @param w Pointer to waiter list.
+ * @param task Task to unregister.
+ */
+static void uart_waiters_remove(uart_dma_waiters_t* w, TaskHandle_t task)
+{
+	taskENTER_CRITICAL();
+	for (size_t i = 0; i < UART_MAX_WAITERS; i++) {
+		if (w->tasks[i] == task)
+			w->tasks[i] = NULL;
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Notify the port's event task, if any (interrupt context).
+ * @param inst Pointer to driver instance.
+ */
+static void uart_event_task_notify_from_isr(uart_dma_buffered_instance_t* inst)
+{
+	TaskHandle_t task = __atomic_load_n(&inst->event_task, __ATOMIC_ACQUIRE);
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	if (task == NULL)
+		return;
+
+	xTaskNotifyFromISR(task, UART_NOTIFY_EVENT, eSetBits, &higher_priority_task_woken);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief Notify and unregister all waiting tasks (interrupt context).
+ * @param w Pointer to waiter list.
+ */
+static void uart_waiters_notify_from_isr(uart_dma_waiters_t* w)
+{
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	UBaseType_t saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+
+	for (size_t i = 0; i < UART_MAX_WAITERS; i++) {
+		if (w->tasks[i] != NULL) {
+			xTaskNotifyFromISR(w->tasks[i], UART_NOTIFY_WAITER, eSetBits, &higher_priority_task_woken);
+			w->tasks[i] = NULL;
+		}
+	}
+
+	taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief Notify the port's event task, if any (task context).
+ * @param inst Pointer to driver instance.
+ */
+static void uart_event_task_notify(uart_dma_buffered_instance_t* inst)
+{
+	TaskHandle_t task = __atomic_load_n(&inst->event_task, __ATOMIC_ACQUIRE);
+
+	if (task != NULL)
+		xTaskNotify(task, UART_NOTIFY_EVENT, eSetBits);
+}
+
+/**
+ * @brief Notify and unregister all waiting tasks (task context).
+ * @param w Pointer to waiter list.
+ */
+static void uart_waiters_notify(uart_dma_waiters_t* w)
+{
+	taskENTER_CRITICAL();
+	for (size_t i = 0; i < UART_MAX_WAITERS; i++) {
+		if (w->tasks[i] != NULL) {
+			xTaskNotify(w->tasks[i], UART_NOTIFY_WAITER, eSetBits);
+			w->tasks[i] = NULL;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Restore the notification of an event that arrived during a wait.
+ *
+ * Waiting for UART_NOTIFY_WAITER also takes the notification state of a
+ * pending UART_NOTIFY_EVENT, whose bit stays set. Without this the event
+ * task would sleep past the event in uart_dma_wait_event().
+ */
+static void uart_event_rearm(void)
+{
+	uint32_t bits = 0;
+
+	xTaskNotifyWait(0, 0, &bits, 0);
+	if (bits & UART_NOTIFY_EVENT)
+		xTaskNotify(xTaskGetCurrentTaskHandle(), 0, eNoAction);
+}
+
+/**
+ * @brief Sleep on a waiter list until a condition holds or a deadline passes.
+ *
+ * @p ready is evaluated before registering and again after, so a ring
+ * event between the two cannot be missed, and once after every wakeup.
+ * It may make progress itself (queue or read data) and is called with
+ * @p context.
+ *
+ * @param w Pointer to waiter list.
+ * @param ready Condition, returns non-zero when done.
+ * @param context Passed to @p ready.
+ * @param time_out Deadline start, from vTaskSetTimeOutState().
+ * @param ticks_to_wait Remaining ticks, updated.
+ * @return Non-zero if @p ready returned non-zero, 0 on timeout.
+ */
+static int uart_waiters_wait(uart_dma_waiters_t* w, int (*ready)(void* context), void* context,
+		TimeOut_t* time_out, TickType_t* ticks_to_wait)
+{
+	TaskHandle_t self = xTaskGetCurrentTaskHandle();
+	int done = 0, slept = 0;
+
+	for (;;) {
+		if (ready(context)) {
+			done = 1;
+			break;
+		}
+
+		// Register first, then look again: an event in between
+		// would otherwise not wake us
+		int registered = uart_waiters_add(w, self);
+		if (ready(context)) {
+			uart_waiters_remove(w, self);
+			done = 1;
+			break;
+		}
+		if (xTaskCheckForTimeOut(time_out, ticks_to_wait) == pdTRUE) {
+			uart_waiters_remove(w, self);
+			break;
+		}
+
+		// All slots taken: fall back to checking once per tick
+		xTaskNotifyWait(UART_NOTIFY_WAITER, UART_NOTIFY_WAITER, NULL, registered ? *ticks_to_wait : 1);
+		uart_waiters_remove(w, self);
+		slept = 1;
+	}
+
+	if (slept)
+		uart_event_rearm();
+	return done;
+}
+
+/**
+ * @brief Queue all data, blocking while the TX ring is full.
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of bytes queued, less than @p size on timeout.
+ */
+size_t uart_tx_queue_dma_transmit_blocking(UART_HandleTypeDef* huart, const uint8_t* data, size_t size, uint32_t timeout)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return 0;
+
+	TickType_t ticks_to_wait = timeout == HAL_MAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+	TimeOut_t time_out;
+
+	vTaskSetTimeOutState(&time_out);
+	return uart_tx_enqueue_blocking(inst, data, size, &time_out, &ticks_to_wait);
+}
+
+/**
+ * @brief Blocking enqueue state, see uart_tx_enqueue_ready().
+ */
+typedef struct {
+	uart_dma_buffered_instance_t* inst;
+	const uint8_t* data;
+	size_t size;
+	size_t queued;
+} uart_tx_enqueue_wait_t;
+
+/**
+ * @brief Queue what fits of the remaining data.
+ * @param context Pointer to uart_tx_enqueue_wait_t.
+ * @return Non-zero once all data is queued.
+ */
+static int uart_tx_enqueue_ready(void* context)
+{
+	uart_tx_enqueue_wait_t* wait = context;
+
+	wait->queued += uart_tx_enqueue_partial(wait->inst, wait->data + wait->queued, wait->size - wait->queued);
+	return wait->queued == wait->size;
+}
+
+/**
+ * @brief Queue data while TX ring space frees up, until a shared deadline.
+ * @param inst Pointer to driver instance.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @param time_out Deadline start, from vTaskSetTimeOutState().
+ * @param ticks_to_wait Remaining ticks, updated.
+ * @return Number of bytes queued, less than @p size on timeout.
+ */
+static size_t uart_tx_enqueue_blocking(uart_dma_buffered_instance_t* inst, const uint8_t* data, size_t size,
+		TimeOut_t* time_out, TickType_t* ticks_to_wait)
+{
+	uart_tx_enqueue_wait_t wait = { .inst = inst, .data = data, .size = size, .queued = 0 };
+
+	uart_waiters_wait(&inst->tx_waiters, uart_tx_enqueue_ready, &wait, time_out, ticks_to_wait);
+	return wait.queued;
+}
+
+/**
+ * @brief Convert a number of character times into microseconds, rounded up.
+ * @param huart Pointer to UART handle.
+ * @param char_times Number of characters.
+ * @return Duration in microseconds at the configured frame format.
+ */
+static uint64_t uart_char_times_us(UART_HandleTypeDef* huart, uint32_t char_times)
+{
+	// Start bit, data bits (parity included) and stop bits
+	uint32_t bits_per_char = 1 + (huart->Init.WordLength == UART_WORDLENGTH_9B ? 9 : 8) +
+			(huart->Init.StopBits == UART_STOPBITS_2 ? 2 : 1);
+
+	return ((uint64_t)char_times * bits_per_char * 1000000u + huart->Init.BaudRate - 1) /
+			huart->Init.BaudRate;
+}
+
+/**
+ * @brief Check whether TX DMA has released the ring up to @p mark.
+ * @param r Pointer to TX ring.
+ * @param mark Value of released_total to reach.
+ * @return Non-zero once reached.
+ */
+static inline int uart_tx_released_past(dma_producer_ring_t* r, uint32_t mark)
+{
+	return (int32_t)(__atomic_load_n(&r->released_total, __ATOMIC_ACQUIRE) - mark) >= 0;
+}
+
+/**
+ * @brief Drain wait state, see uart_tx_drained().
+ */
+typedef struct {
+	dma_producer_ring_t* r;
+	uint32_t mark;
+} uart_tx_drain_wait_t;
+
+/**
+ * @brief Check whether the data queued by uart_write_all() has been sent.
+ * @param context Pointer to uart_tx_drain_wait_t.
+ * @return Non-zero once sent.
+ */
+static int uart_tx_drained(void* context)
+{
+	uart_tx_drain_wait_t* wait = context;
+	return uart_tx_released_past(wait->r, wait->mark);
+}
+
+/**
+ * @brief Write all data and wait until it has been transmitted.
+ * @param huart Pointer to UART handle.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to write.
+ * @param timeout Maximum time for both in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return HAL_OK once sent, HAL_TIMEOUT if the deadline passed first,
+ *         HAL_ERROR if the UART is unknown.
+ */
+HAL_StatusTypeDef uart_write_all(UART_HandleTypeDef* huart, const uint8_t* data, size_t size, uint32_t timeout)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+
+	dma_producer_ring_t* r = inst->tx_ring;
+	mp_ring_buffer_t* rb = r->ring_buffer;
+	TickType_t ticks_to_wait = timeout == HAL_MAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+	TimeOut_t time_out;
+
+	vTaskSetTimeOutState(&time_out);
+	if (uart_tx_enqueue_blocking(inst, data, size, &time_out, &ticks_to_wait) != size)
+		return HAL_TIMEOUT;
+
+	// The ring is FIFO: our last byte is out once everything reserved
+	// by now has been released. Reserved, not committed: an earlier
+	// reservation another task is still filling precedes our data.
+	// Both are read in one critical section so a completion in between
+	// cannot be counted twice.
+	uart_tx_drain_wait_t wait = { .r = r };
+	taskENTER_CRITICAL();
+	wait.mark = r->released_total + (mp_ring_buffer_get_length(rb) - mp_ring_buffer_get_free_size(rb));
+	taskEXIT_CRITICAL();
+
+	if (!uart_waiters_wait(&inst->tx_waiters, uart_tx_drained, &wait, &time_out, &ticks_to_wait))
+		return HAL_TIMEOUT;
+
+#if UART_DMA_BACKEND_LL
+	// Completion fires at DMA transfer complete, when the last byte has
+	// only reached DR. Unless the line is already idle, give the USART
+	// the two character times it needs to shift out DR and the shift register.
+	if (!uart_dma_ll_tx_is_idle(huart))
+		vTaskDelay(pdMS_TO_TICKS((uart_char_times_us(huart, 2) + 999) / 1000) + 1);
+#endif
+	return HAL_OK;
+}
+
+/**
+ * @brief Reserve, fill and commit as much as fits, then start DMA.
+ * @param inst Pointer to driver instance.
+ * @param data Pointer to source data buffer.
+ * @param size Number of bytes to enqueue.
+ * @return Number of bytes queued.
+ */
+static size_t uart_tx_enqueue_partial(uart_dma_buffered_instance_t* inst, const uint8_t* data, size_t size)
+{
+	mp_ring_buffer_t* rb = inst->tx_ring->ring_buffer;
+	uint32_t start;
+
+	if (size == 0)
+		return 0;
+
+	size_t reserved = mp_ring_buffer_reserve_partial(rb, size, &start);
+	if (reserved == 0)
+		return 0;
+
+	mp_ring_buffer_copy_in(rb, start, data, reserved);
+	mp_ring_buffer_commit(rb);
+	UART_TRACE_EVENT(TX_TAIL, inst, atomic_load_explicit(&rb->commit_index, memory_order_relaxed));
+	uart_tx_dma_request(inst);
+
+	return reserved;
+}
+
+/**
+ * @brief Start DMA transmission of queued TX data.
+ *
+ * Initiates DMA for remaining data in the TX ring buffer.
+ *
+ * @param huart Pointer to UART handle.
+ * @return HAL_OK if DMA is running, HAL_ERROR otherwise.
+ */
+HAL_StatusTypeDef uart_start_queued_tx_dma_transmit(UART_HandleTypeDef* huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+
+	// Already transmitting, queued data follows on completion
+	if (!uart_tx_dma_claim(inst))
+		return HAL_OK;
+
+	return uart_tx_dma_run(inst);
+}
+
+/**
+ * @brief Start TX DMA directly out of the RX ring (zero-copy forward).
+ *
+ * Transmits the next contiguous block of pending RX data. The block stays
+ * owned by TX until HAL_UART_TxCpltCallback() releases it to RX.
+ * Caller must own the TX DMA channel.
+ *
+ * @param inst Pointer to driver instance.
+ * @return HAL_OK if DMA started, HAL_ERROR if nothing to forward.
+ */
+static HAL_StatusTypeDef uart_start_forward_tx_dma_transmit(uart_dma_buffered_instance_t* inst)
+{
+	if (!inst->forward.enabled || inst->forward.in_flight != 0)
+		return HAL_ERROR;
+
+	ring_buffer_t* rx_rb = inst->rx_ring->ring_buffer;
+	size_t size_to_forward = get_size_to_produce_per_dma_operation(rx_rb);
+	if (size_to_forward == 0)
+		return HAL_ERROR;
+
+	inst->forward.in_flight = size_to_forward;
+	HAL_StatusTypeDef hal_result = uart_dma_transmit(inst, rx_rb->data + rx_rb->head, size_to_forward);
+	if (hal_result != HAL_OK)
+	{
+		inst->forward.in_flight = 0;
+		return HAL_ERROR;
+	}
+
+	return HAL_OK;
+}
+
+/**
+ * @brief Try to take ownership of the TX DMA channel.
+ * @param inst Pointer to driver instance.
+ * @return Non-zero if the caller now owns the channel.
+ */
+static int uart_tx_dma_claim(uart_dma_buffered_instance_t* inst)
+{
+	int idle = 0;
+	if (!__atomic_compare_exchange_n(&inst->tx_ring->dma_busy, &idle, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+		return 0;
+	UART_TRACE_EVENT(TX_BUSY, inst, 1);
+	return 1;
+}
+
+/**
+ * @brief Check whether anything is waiting for the TX DMA channel.
+ * @param inst Pointer to driver instance.
+ * @return Non-zero if queued or forwardable data exists.
+ */
+static int uart_tx_dma_has_pending(uart_dma_buffered_instance_t* inst)
+{
+	if (mp_ring_buffer_get_used_size(inst->tx_ring->ring_buffer) != 0)
+		return 1;
+	return inst->forward.enabled && inst->forward.in_flight == 0 &&
+		ring_buffer_get_used_size(inst->rx_ring->ring_buffer) != 0;
+}
+
+/**
+ * @brief Start the next transfer on an owned TX channel or release it.
+ *
+ * Queued TX ring data goes first, then forwarded RX data.
+ *
+ * @param inst Pointer to driver instance.
+ * @return HAL_OK if DMA started, HAL_ERROR if the channel was released.
+ */
+static HAL_StatusTypeDef uart_tx_dma_continue(uart_dma_buffered_instance_t* inst)
+{
+	dma_producer_ring_t* r = inst->tx_ring;
+	uint8_t* data;
+	size_t size_to_transmit = mp_ring_buffer_peek_linear(r->ring_buffer, &data);
+
+	if (size_to_transmit != 0) {
+		r->dma_last_size = size_to_transmit;
+#if UART_TX_DMA_PINGPONG
+		// Arm the following block first, TC can fire right after the start
+		uart_tx_dma_prepare_next(inst, size_to_transmit);
+#endif
+		if (uart_dma_transmit(inst, data, size_to_transmit) == HAL_OK)
+			return HAL_OK;
+#if UART_TX_DMA_PINGPONG
+		uart_dma_ll_set_next(inst->huart, NULL, 0);
+#endif
+	} else if (uart_start_forward_tx_dma_transmit(inst) == HAL_OK) {
+		return HAL_OK;
+	}
+
+	r->dma_last_size = 0;
+	UART_TRACE_EVENT(TX_BUSY, inst, 0);
+	__atomic_store_n(&r->dma_busy, 0, __ATOMIC_RELEASE);
+	return HAL_ERROR;
+}
+
+#if UART_TX_DMA_PINGPONG
+/**
+ * @brief Arm the committed block following the current transfer.
+ * @param inst Pointer to driver instance.
+ * @param offset Size of the current transfer.
+ */
+static void uart_tx_dma_prepare_next(uart_dma_buffered_instance_t* inst, size_t offset)
+{
+	uint8_t* data;
+	size_t size = mp_ring_buffer_peek_linear_at(inst->tx_ring->ring_buffer, offset, &data);
+	uart_dma_ll_set_next(inst->huart, data, size);
+}
+#endif
+
+/**
+ * @brief Run an owned TX channel until it is transmitting or released.
+ * @param inst Pointer to driver instance.
+ * @return HAL_OK if DMA is running, HAL_ERROR otherwise.
+ */
+static HAL_StatusTypeDef uart_tx_dma_run(uart_dma_buffered_instance_t* inst)
+{
+	if (uart_tx_dma_continue(inst) == HAL_OK)
+		return HAL_OK;
+
+	// Data committed from an interrupt while the channel was held
+	// would otherwise wait for the next event
+	if (uart_tx_dma_has_pending(inst) && uart_tx_dma_claim(inst))
+		return uart_tx_dma_continue(inst);
+
+	return HAL_ERROR;
+}
+
+/**
+ * @brief Start the TX DMA channel if it is idle.
+ * @param inst Pointer to driver instance.
+ */
+static void uart_tx_dma_kick(uart_dma_buffered_instance_t* inst)
+{
+	if (uart_tx_dma_claim(inst))
+		uart_tx_dma_run(inst);
+}
+
+/**
+ * @brief Arm a compare deadline of a free-running 1 MHz timer.
+ * @param htim Deadline timer.
+ * @param channel Compare channel (TIM_CHANNEL_x).
+ * @param timeout_us Deadline distance from now in microseconds.
+ */
+static void uart_deadline_arm(TIM_HandleTypeDef* htim, uint32_t channel, uint16_t timeout_us)
+{
+	uint32_t channel_shift = channel >> 2;
+
+	// DIER is shared with the other channels, keep the update atomic.
+	// A stale match between clearing and setting the compare only fires early.
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	__HAL_TIM_CLEAR_FLAG(htim, TIM_FLAG_CC1 << channel_shift);
+	__HAL_TIM_SET_COMPARE(htim, channel, (__HAL_TIM_GET_COUNTER(htim) + timeout_us) & 0xFFFFu);
+	__HAL_TIM_ENABLE_IT(htim, TIM_IT_CC1 << channel_shift);
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Cancel a compare deadline.
+ * @param htim Deadline timer.
+ * @param channel Compare channel (TIM_CHANNEL_x).
+ */
+static void uart_deadline_disarm(TIM_HandleTypeDef* htim, uint32_t channel)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	__HAL_TIM_DISABLE_IT(htim, TIM_IT_CC1 << (channel >> 2));
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief Get the compare channel number of a timer event.
+ * @param htim Timer that raised the event.
+ * @return TIM_CHANNEL_x >> 2, UART_DEADLINE_CHANNELS if no channel is active.
+ */
+static inline uint32_t uart_deadline_channel_index(TIM_HandleTypeDef* htim)
+{
+	// HAL reports one active channel bit per callback
+	return htim->Channel != HAL_TIM_ACTIVE_CHANNEL_CLEARED ? (uint32_t)__builtin_ctz(htim->Channel) :
+			UART_DEADLINE_CHANNELS;
+}
+
+/**
+ * @brief Arm the coalescing deadline @p timeout_us from now.
+ * @param c Pointer to coalescing state.
+ */
+static void uart_tx_coalesce_arm(uart_tx_coalesce_t* c)
+{
+	uart_deadline_arm(c->htim, c->channel, c->timeout_us);
+}
+
+/**
+ * @brief Cancel the coalescing deadline.
+ * @param c Pointer to coalescing state.
+ */
+static void uart_tx_coalesce_disarm(uart_tx_coalesce_t* c)
+{
+	uart_deadline_disarm(c->htim, c->channel);
+	__atomic_store_n(&c->armed, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Start TX DMA for newly queued data, subject to coalescing.
+ * @param inst Pointer to driver instance.
+ */
+static void uart_tx_dma_request(uart_dma_buffered_instance_t* inst)
+{
+	uart_tx_coalesce_t* c = &inst->tx_coalesce;
+
+	if (c->threshold == 0 || mp_ring_buffer_get_used_size(inst->tx_ring->ring_buffer) >= c->threshold) {
+		uart_tx_dma_kick(inst);
+		return;
+	}
+
+	// Below threshold: the first held byte starts the deadline
+	if (__atomic_exchange_n(&c->armed, 1, __ATOMIC_ACQ_REL) == 0)
+		uart_tx_coalesce_arm(c);
+}
+
+/**
+ * @brief Configure TX coalescing for a UART.
+ * @param huart Pointer to UART handle.
+ * @param threshold Byte count that starts DMA, 0 to disable coalescing.
+ * @param timeout_us Maximum hold time in microseconds, 1..65535.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART or invalid parameters.
+ */
+HAL_StatusTypeDef uart_tx_set_coalescing(UART_HandleTypeDef* huart, size_t threshold, uint32_t timeout_us)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+
+	uart_tx_coalesce_t* c = &inst->tx_coalesce;
+	if (threshold != 0 && (threshold > mp_ring_buffer_get_length(inst->tx_ring->ring_buffer) ||
+			timeout_us == 0 || timeout_us > 0xFFFFu || c->htim == NULL))
+		return HAL_ERROR;
+
+	c->timeout_us = timeout_us;
+	c->threshold = threshold;
+
+	// Flush anything held under the previous policy
+	uart_tx_coalesce_disarm(c);
+	uart_tx_dma_kick(inst);
+
+	return HAL_OK;
+}
+
+// Callback invoked when a timer compare matches: coalescing deadline or
+// end of an RX aggregation window
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+	uint32_t index = uart_deadline_channel_index(htim);
+	if (index >= UART_DEADLINE_CHANNELS) return;
+
+	uart_dma_buffered_instance_t* tx_inst = uart_tx_deadline_ports[index];
+	if (tx_inst && tx_inst->tx_coalesce.htim == htim) {
+		uart_tx_coalesce_disarm(&tx_inst->tx_coalesce);
+		uart_tx_dma_kick(tx_inst);
+		return;
+	}
+
+	uart_dma_buffered_instance_t* rx_inst = uart_rx_deadline_ports[index];
+	if (rx_inst && rx_inst->rx_aggregate.htim == htim) {
+		uart_rx_aggregate_disarm(&rx_inst->rx_aggregate);
+		uart_rx_deliver_from_isr(rx_inst);
+	}
+}
+
+/**
+ * @brief Enable or disable zero-copy RX to TX forwarding (echo).
+ * @param huart Pointer to UART handle.
+ * @param enable Non-zero to enable forwarding.
+ * @return HAL_OK on success, HAL_ERROR if the UART is unknown.
+ */
+HAL_StatusTypeDef uart_rx_dma_set_forward(UART_HandleTypeDef* huart, int enable)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+#if UART_RX_STREAM_BUFFER
+	if (enable && inst->rx_stream)
+		return HAL_ERROR;
+#endif
+
+	inst->forward.enabled = enable != 0;
+	// Data may already be waiting in the RX ring
+	if (inst->forward.enabled)
+		uart_tx_dma_kick(inst);
+
+	return HAL_OK;
+}
+
+// Callback invoked when DMA TX transfer completes
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	dma_producer_ring_t* r = inst->tx_ring;
+
+	UART_TRACE_EVENT(TX_TC, inst, inst->forward.in_flight != 0 ? inst->forward.in_flight : r->dma_last_size);
+	inst->stats.tx_transfers++;
+	if (inst->forward.in_flight != 0) {
+		// Forwarded RX block is out, hand its space back to RX
+		size_t size_forwarded = inst->forward.in_flight;
+		inst->forward.in_flight = 0;
+		inst->stats.tx_bytes += size_forwarded;
+		uart_rx_dma_commit_pending_data(huart, size_forwarded);
+	} else {
+		inst->stats.tx_bytes += r->dma_last_size;
+		mp_ring_buffer_release(r->ring_buffer, r->dma_last_size);
+		__atomic_store_n(&r->released_total, r->released_total + r->dma_last_size, __ATOMIC_RELEASE);
+		UART_TRACE_EVENT(TX_HEAD, inst, atomic_load_explicit(&r->ring_buffer->read_index, memory_order_relaxed));
+#if UART_TX_DMA_PINGPONG
+		// The armed block is already on the wire, arm the one after it
+		size_t size_chained = uart_dma_ll_take_chained(huart);
+		if (size_chained != 0) {
+			UART_TRACE_EVENT(TX_START, inst, size_chained);
+			r->dma_last_size = size_chained;
+			uart_tx_dma_prepare_next(inst, size_chained);
+			uart_waiters_notify_from_isr(&inst->tx_waiters);
+			uart_event_task_notify_from_isr(inst);
+			return;
+		}
+#endif
+	}
+
+	// Continue transmitting remaining data if any, then forwarded RX data
+	uart_tx_dma_run(inst);
+
+	// Space was released, let blocked writers refill the ring
+	uart_waiters_notify_from_isr(&inst->tx_waiters);
+	uart_event_task_notify_from_isr(inst);
+}
+
+
+/**
+ * @brief Read pending data from RX DMA buffer into user buffer.
+ *
+ * Copies data from the RX ring buffer and starts DMA if idle.
+ *
+ * @param huart Pointer to UART handle.
+ * @param destination Pointer to destination buffer.
+ * @param max_length Maximum number of bytes to read.
+ * @return Number of bytes actually copied.
+ */
+size_t uart_rx_dma_get_pending_data(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	dma_consumer_ring_t* r = inst->rx_ring;
+	ring_buffer_t* rb = r->ring_buffer;
+
+	uart_rx_dma_resync(inst);
+
+	size_t pending_data_size = ring_buffer_get_used_size(rb);
+	if (pending_data_size == 0)
+		return 0;
+
+	int bytes_copied = ring_buffer_read(rb, destination, max_length);
+	UART_TRACE_EVENT(RX_HEAD, inst, rb->head);
+	if (r->dma_busy == 0)
+		uart_start_rx_dma_receive(huart);
+
+	return bytes_copied;
+}
+
+/**
+ * @brief Close the RX aggregation window.
+ * @param a Pointer to aggregation state.
+ */
+static void uart_rx_aggregate_disarm(uart_rx_aggregate_t* a)
+{
+	uart_deadline_disarm(a->htim, a->channel);
+	__atomic_store_n(&a->armed, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Decide whether fresh RX data is held in the aggregation window.
+ *
+ * Called on every RX event with new data. Each event restarts the window,
+ * so it closes only after a full window of silence.
+ *
+ * @param inst Pointer to driver instance.
+ * @return Non-zero if delivery is deferred to the end of the window.
+ */
+static int uart_rx_aggregate_hold(uart_dma_buffered_instance_t* inst)
+{
+	uart_rx_aggregate_t* a = &inst->rx_aggregate;
+
+	if (a->timeout_us == 0)
+		return 0;
+
+	if (ring_buffer_get_used_size(inst->rx_ring->ring_buffer) >= a->threshold) {
+		if (a->armed)
+			uart_rx_aggregate_disarm(a);
+		return 0;
+	}
+
+	__atomic_store_n(&a->armed, 1, __ATOMIC_RELEASE);
+	uart_deadline_arm(a->htim, a->channel, a->timeout_us);
+	return 1;
+}
+
+/**
+ * @brief Wake RX readers and the event task (interrupt context).
+ *
+ * With stream delivery the data is moved into the stream buffer instead,
+ * which wakes its consumer at the trigger level.
+ *
+ * @param inst Pointer to driver instance.
+ */
+static void uart_rx_deliver_from_isr(uart_dma_buffered_instance_t* inst)
+{
+#if UART_RX_STREAM_BUFFER
+	StreamBufferHandle_t stream = __atomic_load_n(&inst->rx_stream, __ATOMIC_ACQUIRE);
+	if (stream) {
+		uart_rx_stream_flush_from_isr(inst, stream);
+		return;
+	}
+#endif
+	uart_waiters_notify_from_isr(&inst->rx_waiters);
+	uart_event_task_notify_from_isr(inst);
+}
+
+/**
+ * @brief Wake RX readers and the event task (task context).
+ * @param inst Pointer to driver instance.
+ */
+static void uart_rx_deliver(uart_dma_buffered_instance_t* inst)
+{
+#if UART_RX_STREAM_BUFFER
+	StreamBufferHandle_t stream = __atomic_load_n(&inst->rx_stream, __ATOMIC_ACQUIRE);
+	if (stream) {
+		uart_rx_stream_flush(inst, stream);
+		return;
+	}
+#endif
+	uart_waiters_notify(&inst->rx_waiters);
+	uart_event_task_notify(inst);
+}
+
+/**
+ * @brief Get the number of RX bytes readers should be woken for.
+ * @param inst Pointer to driver instance.
+ * @return Pending bytes, 0 while an aggregation window holds them.
+ */
+static size_t uart_rx_delivered_size(uart_dma_buffered_instance_t* inst)
+{
+	if (__atomic_load_n(&inst->rx_aggregate.armed, __ATOMIC_ACQUIRE))
+		return 0;
+	return ring_buffer_get_used_size(inst->rx_ring->ring_buffer);
+}
+
+/**
+ * @brief Configure the RX aggregation window of a UART.
+ * @param huart Pointer to UART handle.
+ * @param char_times Window length in character times, 0 disables aggregation.
+ * @param threshold Pending byte count that ends the window early, 0 for half the RX ring.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART or a window above 65535 us.
+ */
+HAL_StatusTypeDef uart_rx_set_aggregation(UART_HandleTypeDef* huart, uint32_t char_times, size_t threshold)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+
+	uart_rx_aggregate_t* a = &inst->rx_aggregate;
+	size_t rx_length = inst->rx_ring->ring_buffer->length;
 
-dma_producer_ring_t uart1_tx_ring = {
-	.ring_buffer = &uart1_tx_ring_buffer,
-	.dma_last_size = 0,
-	.dma_busy = 0
-};
+	uint64_t timeout_us = uart_char_times_us(huart, char_times);
 
+	if (timeout_us > 0xFFFFu || a->htim == NULL)
+		return HAL_ERROR;
 
-dma_consumer_ring_t uart1_rx_ring = {
-	.ring_buffer = &uart1_rx_ring_buffer,
-	.dma_last_size = 0,
-	.dma_busy = 0,
-};
+	// Stop holding first, then release anything held under the old window
+	a->timeout_us = 0;
+	uart_rx_aggregate_disarm(a);
+	a->threshold = threshold != 0 && threshold < rx_length ? threshold : rx_length / 2;
+	a->timeout_us = timeout_us;
 
-uart_dma_buffered_instance_t uart_instances[] = {
-    { &huart1, &uart1_tx_ring, &uart1_rx_ring },
-};
+	if (ring_buffer_get_used_size(inst->rx_ring->ring_buffer) != 0)
+		uart_rx_deliver(inst);
+
+	return HAL_OK;
+}
 
+/**
+ * @brief Check whether a stream buffer takes the port's RX data.
+ * @param inst Pointer to driver instance.
+ * @return Non-zero while stream delivery is enabled.
+ */
+static inline int uart_rx_streaming(uart_dma_buffered_instance_t* inst)
+{
+#if UART_RX_STREAM_BUFFER
+	return __atomic_load_n(&inst->rx_stream, __ATOMIC_ACQUIRE) != NULL;
+#else
+	(void)inst;
+	return 0;
+#endif
+}
 
 /**
- * @brief Retrieve the TX ring buffer associated with a UART instance.
+ * @brief Pending data wait state, see uart_rx_pending_ready().
+ */
+typedef struct {
+	uart_dma_buffered_instance_t* inst;
+	size_t pending;
+} uart_rx_pending_wait_t;
+
+/**
+ * @brief Check for delivered RX data.
+ * @param context Pointer to uart_rx_pending_wait_t.
+ * @return Non-zero once data is pending.
+ */
+static int uart_rx_pending_ready(void* context)
+{
+	uart_rx_pending_wait_t* wait = context;
+
+	uart_rx_dma_resync(wait->inst);
+	wait->pending = uart_rx_delivered_size(wait->inst);
+	return wait->pending != 0;
+}
+
+/**
+ * @brief Wait until RX data is pending.
  * @param huart Pointer to UART handle.
- * @return Pointer to the TX ring buffer, or NULL if not found.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of pending bytes, 0 on timeout, unknown UART or with
+ *         stream delivery enabled.
  */
-dma_producer_ring_t* uart_get_tx_ring(UART_HandleTypeDef* huart)
+size_t uart_rx_dma_wait_pending_data(UART_HandleTypeDef* huart, uint32_t timeout)
 {
-    for (size_t i = 0; i < sizeof(uart_instances)/sizeof(uart_instances[0]); i++) {
-        if (uart_instances[i].huart == huart)
-            return uart_instances[i].tx_ring;
-    }
-    return NULL;
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst || uart_rx_streaming(inst)) return 0;
+
+	TickType_t ticks_to_wait = timeout == HAL_MAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+	TimeOut_t time_out;
+	uart_rx_pending_wait_t wait = { .inst = inst, .pending = 0 };
+
+	vTaskSetTimeOutState(&time_out);
+	uart_waiters_wait(&inst->rx_waiters, uart_rx_pending_ready, &wait, &time_out, &ticks_to_wait);
+	return wait.pending;
 }
 
 /**
- * @brief Retrieve the RX ring buffer associated with a UART instance.
+ * @brief Read received data, blocking until at least one byte arrives.
  * @param huart Pointer to UART handle.
- * @return Pointer to the RX ring buffer, or NULL if not found.
+ * @param destination Pointer to destination buffer.
+ * @param max_length Maximum number of bytes to read.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of bytes copied, 0 on timeout.
  */
-dma_consumer_ring_t* uart_get_rx_ring(UART_HandleTypeDef* huart)
+size_t uart_rx_dma_receive_blocking(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length, uint32_t timeout)
 {
-    for (size_t i = 0; i < sizeof(uart_instances)/sizeof(uart_instances[0]); i++) {
-        if (uart_instances[i].huart == huart)
-            return uart_instances[i].rx_ring;
-    }
-    return NULL;
+	if (max_length == 0 || uart_rx_dma_wait_pending_data(huart, timeout) == 0)
+		return 0;
+
+	return uart_rx_dma_get_pending_data(huart, destination, max_length);
 }
 
 /**
- * @brief Queue data for transmission via DMA.
+ * @brief Read wait state, see uart_read_ready().
+ */
+typedef struct {
+	UART_HandleTypeDef* huart;
+	uint8_t* destination;
+	size_t min_length;
+	size_t max_length;
+	size_t received;
+} uart_read_wait_t;
+
+/**
+ * @brief Read what is pending into the remaining destination space.
+ * @param context Pointer to uart_read_wait_t.
+ * @return Non-zero once at least min_length bytes have been read.
+ */
+static int uart_read_ready(void* context)
+{
+	uart_read_wait_t* wait = context;
+
+	wait->received += uart_rx_dma_get_pending_data(wait->huart, wait->destination + wait->received,
+			wait->max_length - wait->received);
+	return wait->received >= wait->min_length;
+}
+
+/**
+ * @brief Read between @p min_length and @p max_length bytes, blocking.
+ * @param huart Pointer to UART handle.
+ * @param destination Pointer to destination buffer.
+ * @param min_length Bytes to wait for, 0 does not block.
+ * @param max_length Maximum number of bytes to read.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Number of bytes copied, less than @p min_length on timeout,
+ *         0 at once with stream delivery enabled.
+ */
+size_t uart_read(UART_HandleTypeDef* huart, uint8_t* destination, size_t min_length, size_t max_length, uint32_t timeout)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst || max_length == 0 || uart_rx_streaming(inst)) return 0;
+
+	TickType_t ticks_to_wait = timeout == HAL_MAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+	TimeOut_t time_out;
+	uart_read_wait_t wait = {
+		.huart = huart,
+		.destination = destination,
+		.min_length = min_length > max_length ? max_length : min_length,
+		.max_length = max_length,
+		.received = 0,
+	};
+
+	vTaskSetTimeOutState(&time_out);
+	uart_waiters_wait(&inst->rx_waiters, uart_read_ready, &wait, &time_out, &ticks_to_wait);
+	return wait.received;
+}
+
+/**
+ * @brief Set a task to notify on every RX and TX DMA event of a UART.
+ * @param huart Pointer to UART handle.
+ * @param task Task to notify, NULL to stop notifications.
+ * @return HAL_OK on success, HAL_ERROR if the UART is unknown.
+ */
+HAL_StatusTypeDef uart_dma_set_event_task(UART_HandleTypeDef* huart, TaskHandle_t task)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return HAL_ERROR;
+
+	__atomic_store_n(&inst->event_task, task, __ATOMIC_RELEASE);
+	return HAL_OK;
+}
+
+/**
+ * @brief Wait for an event on the ports of the calling event task.
+ * @param timeout Maximum time to wait in milliseconds, HAL_MAX_DELAY waits forever.
+ * @return Non-zero if an event arrived, 0 on timeout.
+ */
+int uart_dma_wait_event(uint32_t timeout)
+{
+	TickType_t ticks_to_wait = timeout == HAL_MAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+	uint32_t bits = 0;
+
+	// A waiter wakeup arriving late only costs a spurious return
+	xTaskNotifyWait(0, UART_NOTIFY_EVENT, &bits, ticks_to_wait);
+	return (bits & UART_NOTIFY_EVENT) != 0;
+}
+
+#if UART_RX_STREAM_BUFFER
+/**
+ * @brief Move what fits from the RX ring into the RX stream buffer.
  *
- * Copies the data into the TX ring buffer and starts DMA if idle.
+ * A stream buffer takes a single writer: callers mask interrupts around
+ * this, so the DMA callbacks and the consumer task never write at once.
+ * What does not fit stays in the RX ring. RX DMA is not touched, the
+ * caller restarts it after unmasking.
  *
+ * @param inst Pointer to driver instance.
+ * @param stream Stream buffer of the port.
+ * @param higher_priority_task_woken Interrupt context: set by the send, NULL from a task.
+ * @return Non-zero if RX ring space was freed.
+ */
+static int uart_rx_stream_fill(uart_dma_buffered_instance_t* inst, StreamBufferHandle_t stream,
+		BaseType_t* higher_priority_task_woken)
+{
+	ring_buffer_t* rb = inst->rx_ring->ring_buffer;
+	ring_buffer_span_t spans[2];
+	size_t sent_size = 0;
+	int resynced = uart_rx_dma_discard_overrun(inst);
+
+	ring_buffer_peek(rb, spans);
+	for (int i = 0; i < 2 && spans[i].length != 0; i++) {
+		size_t span_sent = higher_priority_task_woken ?
+			xStreamBufferSendFromISR(stream, spans[i].data, spans[i].length, higher_priority_task_woken) :
+			xStreamBufferSend(stream, spans[i].data, spans[i].length, 0);
+		sent_size += span_sent;
+		if (span_sent != spans[i].length)
+			break;
+	}
+
+	if (sent_size != 0) {
+		ring_buffer_commit(rb, sent_size);
+		UART_TRACE_EVENT(RX_HEAD, inst, rb->head);
+	}
+	return resynced || sent_size != 0;
+}
+
+/**
+ * @brief Move received data into the RX stream buffer (interrupt context).
+ * @param inst Pointer to driver instance.
+ * @param stream Stream buffer of the port.
+ */
+static void uart_rx_stream_flush_from_isr(uart_dma_buffered_instance_t* inst, StreamBufferHandle_t stream)
+{
+	BaseType_t higher_priority_task_woken = pdFALSE;
+
+	UBaseType_t saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+	int freed = uart_rx_stream_fill(inst, stream, &higher_priority_task_woken);
+	taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+
+	// Restart RX DMA stopped on a full ring
+	if (freed && inst->rx_ring->dma_busy == 0)
+		uart_start_rx_dma_receive(inst->huart);
+
+	portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief Move received data into the RX stream buffer (task context).
+ * @param inst Pointer to driver instance.
+ * @param stream Stream buffer of the port.
+ */
+static void uart_rx_stream_flush(uart_dma_buffered_instance_t* inst, StreamBufferHandle_t stream)
+{
+	taskENTER_CRITICAL();
+	int freed = uart_rx_stream_fill(inst, stream, NULL);
+	taskEXIT_CRITICAL();
+
+	// Restart RX DMA stopped on a full ring
+	if (freed && inst->rx_ring->dma_busy == 0)
+		uart_start_rx_dma_receive(inst->huart);
+}
+
+/**
+ * @brief Deliver RX data of a UART through a FreeRTOS stream buffer.
  * @param huart Pointer to UART handle.
- * @param data Pointer to source data buffer.
- * @param size Number of bytes to enqueue.
- * @return UART_TX_RESULT_QUEUED if successfully queued, UART_TX_RESULT_FAILURE otherwise.
+ * @param trigger_level Bytes that wake the consumer, 1..UART_RX_STREAM_SIZE,
+ *                      0 returns to ring delivery.
+ * @return HAL_OK on success, HAL_ERROR on unknown UART, invalid trigger
+ *         level or forwarding enabled.
  */
-uart_dma_enqueue_tx_result_t uart_tx_queue_dma_transmit(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size)
+HAL_StatusTypeDef uart_rx_set_stream_buffer(UART_HandleTypeDef* huart, size_t trigger_level)
 {
-	dma_producer_ring_t* r = uart_get_tx_ring(huart);
-	if (!r) return UART_TX_RESULT_FAILURE;
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst || trigger_level > UART_RX_STREAM_SIZE) return HAL_ERROR;
 
-	ring_buffer_t* rb = r->ring_buffer;
+	if (trigger_level == 0) {
+		__atomic_store_n(&inst->rx_stream, NULL, __ATOMIC_RELEASE);
+		return HAL_OK;
+	}
 
-	if (size == 0)
-		return UART_TX_RESULT_FAILURE;
-	if (ring_buffer_get_free_size(rb) < size)
-		return UART_TX_RESULT_FAILURE;
+	// Forwarded data leaves through TX DMA, it cannot be streamed as well
+	if (inst->forward.enabled)
+		return HAL_ERROR;
 
-	if (ring_buffer_write(rb, data, size) != 0)
-		return UART_TX_RESULT_FAILURE;
+	StreamBufferHandle_t stream = inst->rx_stream;
+	if (stream) {
+		xStreamBufferSetTriggerLevel(stream, trigger_level);
+	} else {
+		stream = xStreamBufferCreateStatic(UART_RX_STREAM_SIZE, trigger_level,
+			inst->rx_stream_storage, inst->rx_stream_static);
+		__atomic_store_n(&inst->rx_stream, stream, __ATOMIC_RELEASE);
+	}
 
-	// Start DMA immediately if not already busy
-	if (r->dma_busy == 0)
-		uart_start_queued_tx_dma_transmit(huart);
+	// Data may already be waiting in the RX ring
+	uart_rx_stream_flush(inst, stream);
+	return HAL_OK;
+}
 
-	return UART_TX_RESULT_QUEUED;
+/**
+ * @brief Get the RX stream buffer of a UART.
+ * @param huart Pointer to UART handle.
+ * @return Stream buffer handle, NULL if stream delivery is not enabled.
+ */
+StreamBufferHandle_t uart_rx_get_stream_buffer(UART_HandleTypeDef* huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return NULL;
+
+	return __atomic_load_n(&inst->rx_stream, __ATOMIC_ACQUIRE);
 }
 
 /**
- * @brief Start DMA transmission of queued TX data.
+ * @brief Receive from the RX stream buffer, blocking up to @p timeout.
+ * @param huart Pointer to UART handle.
+ * @param destination Pointer to destination buffer.
+ * @param max_length Maximum number of bytes to read.
+ * @param timeout Maximum time to wait, in ticks.
+ * @return Number of bytes copied, 0 on timeout or without stream delivery.
+ */
+size_t uart_rx_stream_receive(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length, uint32_t timeout)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return 0;
+
+	StreamBufferHandle_t stream = __atomic_load_n(&inst->rx_stream, __ATOMIC_ACQUIRE);
+	if (!stream) return 0;
+
+	size_t received_size = xStreamBufferReceive(stream, destination, max_length, timeout);
+
+	// Space was freed, move what the RX ring held back
+	uart_rx_stream_flush(inst, stream);
+	return received_size;
+}
+#endif
+
+/**
+ * @brief Get pending RX data in place, without copying.
  *
- * Initiates DMA for remaining data in the TX ring buffer.
+ * Fills up to two spans pointing into the RX ring buffer. The data stays
+ * valid until released with uart_rx_dma_commit_pending_data().
  *
  * @param huart Pointer to UART handle.
- * @return HAL_OK if DMA started successfully, HAL_ERROR otherwise.
+ * @param spans Output array of two spans.
+ * @return Total number of pending bytes.
  */
-HAL_StatusTypeDef uart_start_queued_tx_dma_transmit(UART_HandleTypeDef* huart)
+size_t uart_rx_dma_peek_pending_data(UART_HandleTypeDef* huart, ring_buffer_span_t spans[2])
 {
-	dma_producer_ring_t* r = uart_get_tx_ring(huart);
-	if (!r) return HAL_ERROR;
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return 0;
+
+	uart_rx_dma_resync(inst);
+	return ring_buffer_peek(inst->rx_ring->ring_buffer, spans);
+}
+
+/**
+ * @brief Release RX data obtained with uart_rx_dma_peek_pending_data().
+ *
+ * Frees ring space and starts DMA if idle.
+ *
+ * @param huart Pointer to UART handle.
+ * @param length Number of bytes processed.
+ */
+void uart_rx_dma_commit_pending_data(UART_HandleTypeDef* huart, size_t length)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst || length == 0) return;
+
+	dma_consumer_ring_t* r = inst->rx_ring;
+
+	// Data peeked before an overrun was discarded together with the ring
+	if (uart_rx_dma_resync(inst))
+		return;
+
+	ring_buffer_commit(r->ring_buffer, length);
+	UART_TRACE_EVENT(RX_HEAD, inst, r->ring_buffer->head);
+	if (r->dma_busy == 0)
+		uart_start_rx_dma_receive(huart);
+}
 
+/**
+ * @brief Start circular DMA reception over the whole RX ring.
+ *
+ * Circular DMA always begins at the start of the buffer, so the ring
+ * indices are moved there while the ring is empty.
+ *
+ * @param huart Pointer to UART handle.
+ * @param r Pointer to RX ring.
+ * @return HAL_OK if DMA is running, HAL_ERROR otherwise.
+ */
+static HAL_StatusTypeDef uart_start_rx_dma_circular_receive(UART_HandleTypeDef* huart, dma_consumer_ring_t* r)
+{
 	ring_buffer_t* rb = r->ring_buffer;
 
-	int size_to_transmit = get_size_to_produce_per_dma_operation(rb);
+	// Still owned when resuming from the normal transfer that just ended
+	if (r->dma_busy && uart_dma_rx_is_active(huart))
+		return HAL_OK;
 
-	if (size_to_transmit == 0) {
-		r->dma_busy = 0;
-	    return HAL_ERROR;
+	if (rb->tail != 0) {
+		if (ring_buffer_get_used_size(rb) != 0)
+			return HAL_ERROR;
+		rb->head = 0;
+		rb->tail = 0;
 	}
 
-	r->dma_busy = 1;
-	r->dma_last_size = size_to_transmit;
-	HAL_StatusTypeDef hal_result = HAL_UART_Transmit_DMA(huart, rb->data + rb->head, size_to_transmit);
+	uart_rx_dma_set_busy(huart, r, 1);
+	r->dma_circular = 1;
+	r->dma_position = 0;
+	r->dma_overrun = 0;
+	HAL_StatusTypeDef hal_result = uart_dma_receive_to_idle(huart, rb->data, rb->length);
 	if (hal_result != HAL_OK)
 	{
-		r->dma_busy = 0;
+		uart_rx_dma_set_busy(huart, r, 0);
 		return HAL_ERROR;
 	}
 
 	return HAL_OK;
 }
 
-// Callback invoked when DMA TX transfer completes
-void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+/**
+ * @brief Account bytes written by circular RX DMA since the last event.
+ * @param huart Pointer to UART handle.
+ * @param r Pointer to RX ring.
+ * @return Number of bytes received since the last event.
+ */
+static size_t uart_rx_dma_circular_update(UART_HandleTypeDef* huart, dma_consumer_ring_t* r)
 {
-	dma_producer_ring_t* r = uart_get_tx_ring(huart);
 	ring_buffer_t* rb = r->ring_buffer;
 
-    int size_to_send_completed = r->dma_last_size;
-    ring_buffer_produce(rb, size_to_send_completed);
-    int size_to_transmit_pending = get_size_to_produce_per_dma_operation(rb);
+	// Events can be late or merged, the counter is the real write position
+	size_t position = rb->length - __HAL_DMA_GET_COUNTER(huart->hdmarx);
+	if (position >= rb->length)
+		position = 0;
 
-    // Continue transmitting remaining data if any
-    if (size_to_transmit_pending != 0) {
-    	uart_start_queued_tx_dma_transmit(huart);
-    } else {
-        r->dma_busy = 0;
-    }
-}
+	size_t new_bytes_received = (position + rb->length - r->dma_position) % rb->length;
+	r->dma_position = position;
+	if (new_bytes_received == 0)
+		return 0;
+
+	if (!r->dma_overrun && new_bytes_received <= ring_buffer_get_free_size(rb)) {
+		ring_buffer_consume(rb, new_bytes_received);
+		return new_bytes_received;
+	}
 
+	// DMA has overwritten unread bytes. Keep the write index on the DMA
+	// position and report the ring full until the reader resynchronizes.
+	if (!r->dma_overrun)
+		r->dma_overrun_count++;
+	r->dma_overrun = 1;
+	rb->tail = position;
+	__atomic_store_n(&rb->available_size, 0, __ATOMIC_RELEASE);
+	return new_bytes_received;
+}
 
 /**
- * @brief Read pending data from RX DMA buffer into user buffer.
- *
- * Copies data from the RX ring buffer and starts DMA if idle.
- *
- * @param huart Pointer to UART handle.
- * @param destination Pointer to destination buffer.
- * @param max_length Maximum number of bytes to read.
- * @return Number of bytes actually copied.
+ * @brief Discard the RX ring after a circular DMA overrun, without restarting DMA.
+ * @param inst Pointer to driver instance.
+ * @return Non-zero if the ring was discarded.
  */
-size_t uart_rx_dma_get_pending_data(UART_HandleTypeDef* huart, uint8_t* destination, size_t max_length)
+static int uart_rx_dma_discard_overrun(uart_dma_buffered_instance_t* inst)
 {
-	dma_consumer_ring_t* r = uart_get_rx_ring(huart);
+	dma_consumer_ring_t* r = inst->rx_ring;
 	ring_buffer_t* rb = r->ring_buffer;
+	int resynced = 0;
 
-	size_t pending_data_size = ring_buffer_get_used_size(rb);
-	if (pending_data_size == 0)
+	if (!__atomic_load_n(&r->dma_overrun, __ATOMIC_ACQUIRE))
 		return 0;
 
-	int bytes_copied = ring_buffer_read(rb, destination, max_length);
-	if (r->dma_busy == 0)
-		uart_start_rx_dma_receive(huart);
+	UBaseType_t saved_interrupt_status = taskENTER_CRITICAL_FROM_ISR();
+	if (r->dma_overrun && inst->forward.in_flight == 0) {
+		rb->head = rb->tail;
+		__atomic_store_n(&rb->available_size, rb->length, __ATOMIC_RELEASE);
+		r->dma_overrun = 0;
+		resynced = 1;
+	}
+	taskEXIT_CRITICAL_FROM_ISR(saved_interrupt_status);
+	if (resynced)
+		UART_TRACE_EVENT(RX_HEAD, inst, rb->head);
 
-	return bytes_copied;
+	return resynced;
+}
+
+/**
+ * @brief Discard the RX ring after a circular DMA overrun.
+ *
+ * Called on the reader side, from tasks or from TX completion. Waits
+ * while TX DMA still forwards from the ring, its completion
+ * resynchronizes instead.
+ *
+ * @param inst Pointer to driver instance.
+ * @return Non-zero if the ring was discarded.
+ */
+static int uart_rx_dma_resync(uart_dma_buffered_instance_t* inst)
+{
+	int resynced = uart_rx_dma_discard_overrun(inst);
+
+	// An error recovery could not restart DMA into the full ring
+	if (resynced && inst->rx_ring->dma_busy == 0)
+		uart_start_rx_dma_receive(inst->huart);
+
+	return resynced;
 }
 
 /**
  * @brief Start DMA reception into RX ring buffer.
  *
- * Initiates a DMA transfer to fill the RX ring buffer.
+ * Initiates a DMA transfer to fill the RX ring buffer, or one endless
+ * transfer over the whole ring if the channel is DMA_CIRCULAR.
  *
  * @param huart Pointer to UART handle.
  * @return HAL_OK if DMA started successfully, HAL_ERROR otherwise.
@@ -201,20 +1736,30 @@ HAL_StatusTypeDef uart_start_rx_dma_receive(UART_HandleTypeDef* huart)
 	if (!r) return HAL_ERROR;
 
 	ring_buffer_t* rb = r->ring_buffer;
+
+	// Back to one endless transfer once the write index reached the ring start
+	if (r->dma_circular_resume && (rb->tail == 0 || ring_buffer_get_used_size(rb) == 0)) {
+		r->dma_circular_resume = 0;
+		uart_rx_dma_set_circular(huart, 1);
+	}
+
+	if (huart->hdmarx->Init.Mode == DMA_CIRCULAR)
+		return uart_start_rx_dma_circular_receive(huart, r);
+
 	int size_to_receive = get_size_to_consume_per_dma_operation(rb);
 
 	if (ring_buffer_get_free_size(rb) == 0) {
-		r->dma_busy = 0;
+		uart_rx_dma_set_busy(huart, r, 0);
 	    return HAL_ERROR;
 	}
 
-	r->dma_busy = 1;
+	uart_rx_dma_set_busy(huart, r, 1);
 	r->dma_last_size = size_to_receive;
 	r->dma_received_during_current_transfer = 0;
-	HAL_StatusTypeDef hal_result = HAL_UARTEx_ReceiveToIdle_DMA(huart, rb->data + rb->tail, size_to_receive);
+	HAL_StatusTypeDef hal_result = uart_dma_receive_to_idle(huart, rb->data + rb->tail, size_to_receive);
 	if (hal_result != HAL_OK)
 	{
-		r->dma_busy = 0;
+		uart_rx_dma_set_busy(huart, r, 0);
 		return HAL_ERROR;
 	}
 
@@ -224,7 +1769,48 @@ HAL_StatusTypeDef uart_start_rx_dma_receive(UART_HandleTypeDef* huart)
 // Callback invoked on RX DMA event (e.g., IDLE or partial reception)
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size_to_receive_completed)
 {
-	dma_consumer_ring_t* r = uart_get_rx_ring(huart);
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	dma_consumer_ring_t* r = inst->rx_ring;
+
+	size_t new_bytes_received;
+
+	if (r->dma_circular) {
+		// DMA keeps running, only the write position moves
+		new_bytes_received = uart_rx_dma_circular_update(huart, r);
+	} else {
+		new_bytes_received = uart_rx_dma_normal_update(huart, r, size_to_receive_completed);
+	}
+	inst->stats.rx_events++;
+	inst->stats.rx_bytes += new_bytes_received;
+#if UART_TRACE
+	if (huart->RxEventType == HAL_UART_RXEVENT_IDLE)
+		UART_TRACE_EVENT(RX_IDLE, inst, new_bytes_received);
+	else if (huart->RxEventType == HAL_UART_RXEVENT_HT)
+		UART_TRACE_EVENT(RX_HT, inst, new_bytes_received);
+	else
+		UART_TRACE_EVENT(RX_TC, inst, new_bytes_received);
+	UART_TRACE_EVENT(RX_TAIL, inst, r->ring_buffer->tail);
+#endif
+
+	// Wake readers right away instead of on their next poll,
+	// unless an aggregation window holds the data back
+	if (new_bytes_received != 0 && !uart_rx_aggregate_hold(inst))
+		uart_rx_deliver_from_isr(inst);
+
+    // Echo mode: send the freshly committed block straight back
+    if (inst->forward.enabled)
+    	uart_tx_dma_kick(inst);
+}
+
+/**
+ * @brief Account bytes of a normal mode RX transfer and re-arm DMA.
+ * @param huart Pointer to UART handle.
+ * @param r Pointer to RX ring.
+ * @param size_to_receive_completed Bytes received in the current transfer so far.
+ * @return Number of bytes received since the last event.
+ */
+static size_t uart_rx_dma_normal_update(UART_HandleTypeDef* huart, dma_consumer_ring_t* r, uint16_t size_to_receive_completed)
+{
 	ring_buffer_t* rb = r->ring_buffer;
 	size_t new_bytes_received = size_to_receive_completed - r->dma_received_during_current_transfer;
     ring_buffer_consume(rb, new_bytes_received);
@@ -232,13 +1818,163 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size_to_rece
 	r->dma_received_during_current_transfer += new_bytes_received;
 
 	// Check if DMA is still active
-	HAL_DMA_StateTypeDef state = HAL_DMA_GetState(huart->hdmarx);
-	int is_dma_still_active = (state == HAL_DMA_STATE_BUSY);
+	int is_dma_still_active = uart_dma_rx_is_active(huart);
 
     // Start next DMA receive if pending and previous transfer finished
     if (size_to_receive_pending != 0 && !is_dma_still_active) {
     	uart_start_rx_dma_receive(huart);
-    } else if (!is_dma_still_active && size_to_receive_pending) {
-        r->dma_busy = 0;
+    } else if (!is_dma_still_active) {
+        // Ring is full, DMA is restarted when space gets committed
+        uart_rx_dma_set_busy(huart, r, 0);
     }
+    return new_bytes_received;
+}
+
+/**
+ * @brief Switch the RX DMA channel between circular and normal mode.
+ *
+ * CIRC is applied when the channel gets enabled, the channel must be
+ * stopped.
+ *
+ * @param huart Pointer to UART handle.
+ * @param enable Non-zero for circular mode.
+ */
+static void uart_rx_dma_set_circular(UART_HandleTypeDef* huart, int enable)
+{
+	DMA_HandleTypeDef* hdma = huart->hdmarx;
+
+	hdma->Init.Mode = enable ? DMA_CIRCULAR : DMA_NORMAL;
+	MODIFY_REG(hdma->Instance->CCR, DMA_CCR_CIRC, hdma->Init.Mode);
+}
+
+/**
+ * @brief Restart RX DMA after a reception error stopped it.
+ *
+ * Bytes DMA wrote before the abort are committed first, nothing already
+ * in the ring is dropped. Circular DMA can only restart at the ring
+ * start: with unread data in the ring, reception continues in normal
+ * mode from the write index and returns to circular mode when that
+ * wraps to the ring start or the ring drains.
+ *
+ * @param inst Pointer to driver instance.
+ * @param error HAL_UART_ERROR_x bits reported for the stop.
+ * @return Number of bytes committed to the ring.
+ */
+static size_t uart_rx_dma_recover(uart_dma_buffered_instance_t* inst, uint32_t error)
+{
+	UART_HandleTypeDef* huart = inst->huart;
+	dma_consumer_ring_t* r = inst->rx_ring;
+	ring_buffer_t* rb = r->ring_buffer;
+	size_t new_bytes_received;
+
+	if (!r->dma_busy)
+		return 0;
+
+#if !UART_DMA_BACKEND_LL
+	// A TX DMA error ends reception too (UART_DMAError): IDLE detection
+	// is off while the channel keeps running. Stop it and restart.
+	if (huart->ReceptionType != HAL_UART_RECEPTION_TOIDLE && uart_dma_rx_is_active(huart))
+		HAL_DMA_Abort(huart->hdmarx);
+#endif
+	if (uart_dma_rx_is_active(huart))
+		return 0;
+
+	// The channel is stopped, its counter is the final write position
+	if (r->dma_circular) {
+		new_bytes_received = uart_rx_dma_circular_update(huart, r);
+	} else {
+		new_bytes_received = huart->RxXferSize - __HAL_DMA_GET_COUNTER(huart->hdmarx) -
+			r->dma_received_during_current_transfer;
+		ring_buffer_consume(rb, new_bytes_received);
+	}
+
+	// Clear the error flags (SR then DR read). After a bare overrun DR
+	// still holds a good byte DMA did not take, keep it.
+	uint32_t status = huart->Instance->SR;
+	uint8_t data = (uint8_t)huart->Instance->DR;
+	if ((status & USART_SR_RXNE) && !(error & (HAL_UART_ERROR_PE | HAL_UART_ERROR_FE | HAL_UART_ERROR_NE)) &&
+			!r->dma_overrun && ring_buffer_get_free_size(rb) != 0) {
+		rb->data[rb->tail] = data;
+		ring_buffer_consume(rb, 1);
+		new_bytes_received++;
+	}
+
+	if (r->dma_circular && rb->tail != 0 && ring_buffer_get_used_size(rb) != 0) {
+		uart_rx_dma_set_circular(huart, 0);
+		r->dma_circular = 0;
+		r->dma_circular_resume = 1;
+	}
+
+	inst->stats.rx_dma_restarts++;
+	uart_rx_dma_set_busy(huart, r, 0);
+	uart_start_rx_dma_receive(huart);
+	return new_bytes_received;
+}
+
+/**
+ * @brief USART error callback: count the error and restart stopped DMA.
+ *
+ * HAL aborts RX DMA on any reception error while DMA reception is on.
+ * A TX DMA transfer error stops TX DMA and ends reception as well, with
+ * the RX channel still running. The LL backend reports reception errors
+ * with DMA still running, then only the counters move, and an RX DMA
+ * transfer error with the channel stopped.
+ *
+ * @param huart Pointer to UART handle.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	uart_dma_buffered_instance_t* inst = uart_get_instance(huart);
+	if (!inst) return;
+
+	uint32_t error = huart->ErrorCode;
+	huart->ErrorCode = HAL_UART_ERROR_NONE;
+	UART_TRACE_EVENT(RX_ERROR, inst, error);
+
+	if (error & HAL_UART_ERROR_ORE)
+		inst->stats.rx_overrun_errors++;
+	if (error & HAL_UART_ERROR_FE)
+		inst->stats.rx_framing_errors++;
+	if (error & HAL_UART_ERROR_NE)
+		inst->stats.rx_noise_errors++;
+	if (error & HAL_UART_ERROR_PE)
+		inst->stats.rx_parity_errors++;
+
+	size_t new_bytes_received = uart_rx_dma_recover(inst, error);
+	UART_TRACE_EVENT(RX_TAIL, inst, inst->rx_ring->ring_buffer->tail);
+	if (new_bytes_received != 0) {
+		inst->stats.rx_bytes += new_bytes_received;
+		if (!uart_rx_aggregate_hold(inst))
+			uart_rx_deliver_from_isr(inst);
+	}
+
+#if !UART_DMA_BACKEND_LL
+	// HAL ended the TX transfer. Drop the block like the LL backend does,
+	// so its ring space is released and the channel owner moves on.
+	if ((error & HAL_UART_ERROR_DMA) && (huart->hdmatx->ErrorCode & HAL_DMA_ERROR_TE) &&
+			huart->gState == HAL_UART_STATE_READY) {
+		huart->hdmatx->ErrorCode = HAL_DMA_ERROR_NONE;
+		inst->stats.tx_dma_errors++;
+		HAL_UART_TxCpltCallback(huart);
+		return;
+	}
+#endif
+
+	if (inst->forward.enabled)
+		uart_tx_dma_kick(inst);
+}
+
+#if UART_DMA_PROFILE
+/**
+ * @brief Start the DWT cycle counter and clear DMA restart statistics.
+ */
+void uart_dma_profile_reset(void)
+{
+	// Only differences of CYCCNT are used, leave it running for CPU_PROFILE
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	for (size_t i = 0; i < UART_PORT_COUNT; i++)
+		memset(&uart_instances[i].profile, 0, sizeof(uart_instances[i].profile));
 }
+#endif
@@ -0,0 +1,84 @@
+/*
+ * ring_copy.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include "ring_copy.h"
+#include <string.h>
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define RING_COPY_USE_LDM_STM 1
+#else
+#define RING_COPY_USE_LDM_STM 0
+#endif
+
+// Stop GCC from turning the byte loops back into memcpy calls
+#if defined(__GNUC__) && !defined(__clang__)
+#define RING_COPY_NO_LIBCALL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define RING_COPY_NO_LIBCALL
+#endif
+
+
+// Single 32-bit load/store; memcpy lets the compiler emit a plain
+// LDR/STR (unaligned capable on Cortex-M3) without aliasing issues
+static inline void ring_copy_word(uint8_t* dst, const uint8_t* src)
+{
+	uint32_t word;
+	memcpy(&word, src, sizeof(word));
+	memcpy(dst, &word, sizeof(word));
+}
+
+/**
+ * @brief Copy memory for ring buffer wrap handling.
+ * @param dst Destination buffer.
+ * @param src Source buffer.
+ * @param len Number of bytes to copy.
+ */
+RING_COPY_NO_LIBCALL
+void ring_copy(uint8_t* dst, const uint8_t* src, size_t len)
+{
+	if (len < RING_COPY_SMALL_SIZE) {
+		while (len--)
+			*dst++ = *src++;
+		return;
+	}
+
+	// Head: align destination so every store below is a word store
+	while (((uintptr_t)dst & 3u) != 0) {
+		*dst++ = *src++;
+		len--;
+	}
+
+#if RING_COPY_USE_LDM_STM
+	// Bulk: both pointers aligned, move 16 bytes per LDM/STM pair
+	if (((uintptr_t)src & 3u) == 0 && len >= 16) {
+		size_t blocks = len >> 4;
+		len &= 15u;
+		__asm__ volatile (
+			"1:                          \n"
+			"    ldmia %[s]!, {r3-r6}    \n"
+			"    stmia %[d]!, {r3-r6}    \n"
+			"    subs  %[n], %[n], #1    \n"
+			"    bne   1b                \n"
+			: [s] "+r" (src), [d] "+r" (dst), [n] "+r" (blocks)
+			:
+			: "r3", "r4", "r5", "r6", "cc", "memory"
+		);
+	}
+#endif
+
+	// Bulk (or rest of it): 32-bit words, source may be unaligned
+	while (len >= 4) {
+		ring_copy_word(dst, src);
+		dst += 4;
+		src += 4;
+		len -= 4;
+	}
+
+	// Tail
+	while (len--)
+		*dst++ = *src++;
+}
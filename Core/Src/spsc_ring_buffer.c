@@ -0,0 +1,160 @@
+/*
+ * spsc_ring_buffer.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include "spsc_ring_buffer.h"
+#include <string.h>
+
+
+/**
+ * @brief Initialize ring buffer over caller provided storage.
+ * @param rb Pointer to ring buffer instance.
+ * @param storage Backing memory.
+ * @param size Size of backing memory, must be a power of two.
+ * @return 0 on success, -1 if @p size is not a power of two.
+ */
+int spsc_ring_buffer_init(spsc_ring_buffer_t* rb, uint8_t* storage, size_t size)
+{
+	if (!POW2_RING_BUFFER_IS_VALID_SIZE(size))
+		return -1;
+
+	rb->data = storage;
+	rb->mask = size - 1;
+	atomic_init(&rb->read_index, 0);
+	atomic_init(&rb->write_index, 0);
+	return 0;
+}
+
+/**
+ * @brief Get number of bytes readable by the consumer.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of used bytes.
+ */
+size_t spsc_ring_buffer_get_used_size(spsc_ring_buffer_t* rb)
+{
+	// Own index can be read relaxed, the other side's needs acquire
+	size_t read_index = atomic_load_explicit(&rb->read_index, memory_order_relaxed);
+	size_t write_index = atomic_load_explicit(&rb->write_index, memory_order_acquire);
+	return write_index - read_index;
+}
+
+/**
+ * @brief Get number of bytes writable by the producer.
+ * @param rb Pointer to ring buffer instance.
+ * @return Number of free bytes.
+ */
+size_t spsc_ring_buffer_get_free_size(spsc_ring_buffer_t* rb)
+{
+	size_t write_index = atomic_load_explicit(&rb->write_index, memory_order_relaxed);
+	size_t read_index = atomic_load_explicit(&rb->read_index, memory_order_acquire);
+	return rb->mask + 1 - (write_index - read_index);
+}
+
+/**
+ * @brief Write data into ring buffer (producer side).
+ * @param rb Pointer to ring buffer instance.
+ * @param src Source data buffer.
+ * @param len Number of bytes to write.
+ * @return 0 on success, -1 if there is not enough free space.
+ */
+int spsc_ring_buffer_write(spsc_ring_buffer_t* rb, const uint8_t* src, size_t len)
+{
+	if (len == 0)
+		return 0;
+	if (len > spsc_ring_buffer_get_free_size(rb))
+		return -1;
+
+	size_t write_index = atomic_load_explicit(&rb->write_index, memory_order_relaxed);
+	size_t offset = write_index & rb->mask;
+	size_t size_till_ring_wrap = rb->mask + 1 - offset;
+	size_t size_to_append_after_tail = len >= size_till_ring_wrap ? size_till_ring_wrap : len;
+
+	// Copy data until the end of buffer, then wrap around if needed
+	memcpy(rb->data + offset, src, size_to_append_after_tail);
+	memcpy(rb->data, src + size_to_append_after_tail, len - size_to_append_after_tail);
+
+	// Data must be visible before the consumer sees the new index
+	atomic_store_explicit(&rb->write_index, write_index + len, memory_order_release);
+	return 0;
+}
+
+/**
+ * @brief Read data from ring buffer (consumer side).
+ * @param rb Pointer to ring buffer instance.
+ * @param dst Destination buffer.
+ * @param len Maximum number of bytes to read.
+ * @return Number of bytes actually read.
+ */
+size_t spsc_ring_buffer_read(spsc_ring_buffer_t* rb, uint8_t* dst, size_t len)
+{
+	size_t pending_size = spsc_ring_buffer_get_used_size(rb);
+
+	if (len == 0 || pending_size == 0)
+		return 0;
+	if (len > pending_size)
+		len = pending_size;
+
+	size_t read_index = atomic_load_explicit(&rb->read_index, memory_order_relaxed);
+	size_t offset = read_index & rb->mask;
+	size_t size_till_ring_wrap = rb->mask + 1 - offset;
+	size_t size_to_copy_till_ring_wrap = len > size_till_ring_wrap ? size_till_ring_wrap : len;
+
+	// Copy data until end of buffer, then wrap around if necessary
+	memcpy(dst, rb->data + offset, size_to_copy_till_ring_wrap);
+	memcpy(dst + size_to_copy_till_ring_wrap, rb->data, len - size_to_copy_till_ring_wrap);
+
+	// Reads must complete before the producer may overwrite the space
+	atomic_store_explicit(&rb->read_index, read_index + len, memory_order_release);
+	return len;
+}
+
+/**
+ * @brief Number of free bytes writable without crossing the buffer end.
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear writable block starting at write index.
+ */
+size_t spsc_ring_buffer_get_linear_free_size(spsc_ring_buffer_t* rb)
+{
+	size_t free_size = spsc_ring_buffer_get_free_size(rb);
+	size_t write_index = atomic_load_explicit(&rb->write_index, memory_order_relaxed);
+	size_t size_till_ring_wrap = rb->mask + 1 - (write_index & rb->mask);
+	return free_size < size_till_ring_wrap ? free_size : size_till_ring_wrap;
+}
+
+/**
+ * @brief Number of used bytes readable without crossing the buffer end.
+ * @param rb Pointer to ring buffer instance.
+ * @return Size of the linear readable block starting at read index.
+ */
+size_t spsc_ring_buffer_get_linear_used_size(spsc_ring_buffer_t* rb)
+{
+	size_t used_size = spsc_ring_buffer_get_used_size(rb);
+	size_t read_index = atomic_load_explicit(&rb->read_index, memory_order_relaxed);
+	size_t size_till_ring_wrap = rb->mask + 1 - (read_index & rb->mask);
+	return used_size < size_till_ring_wrap ? used_size : size_till_ring_wrap;
+}
+
+/**
+ * @brief Publish @p len bytes filled in place (e.g. by RX DMA).
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes produced.
+ */
+void spsc_ring_buffer_commit_write(spsc_ring_buffer_t* rb, size_t len)
+{
+	size_t write_index = atomic_load_explicit(&rb->write_index, memory_order_relaxed);
+	atomic_store_explicit(&rb->write_index, write_index + len, memory_order_release);
+}
+
+/**
+ * @brief Release @p len bytes drained in place (e.g. by TX DMA).
+ * @param rb Pointer to ring buffer instance.
+ * @param len Number of bytes consumed.
+ */
+void spsc_ring_buffer_commit_read(spsc_ring_buffer_t* rb, size_t len)
+{
+	size_t read_index = atomic_load_explicit(&rb->read_index, memory_order_relaxed);
+	atomic_store_explicit(&rb->read_index, read_index + len, memory_order_release);
+}
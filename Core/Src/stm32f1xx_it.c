@@ -22,6 +22,8 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include <ring_buffered_uart_dma.h>
+#include <cpu_profile.h>
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -57,7 +59,15 @@
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef hdma_usart1_rx;
 extern DMA_HandleTypeDef hdma_usart1_tx;
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
+extern DMA_HandleTypeDef hdma_usart3_rx;
+extern DMA_HandleTypeDef hdma_usart3_tx;
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
 extern UART_HandleTypeDef huart1;
+extern UART_HandleTypeDef huart2;
+extern UART_HandleTypeDef huart3;
 extern TIM_HandleTypeDef htim1;
 
 /* USER CODE BEGIN EV */
@@ -162,17 +172,60 @@ void DebugMon_Handler(void)
 /* please refer to the startup file (startup_stm32f1xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles DMA1 channel2 global interrupt.
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(DMA1_Channel2);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_tx_irq_handler(&huart3);
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel2);
+  return;
+#endif
+  /* USER CODE END DMA1_Channel2_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart3_tx);
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel2);
+  /* USER CODE END DMA1_Channel2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel3 global interrupt.
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel3_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(DMA1_Channel3);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_rx_irq_handler(&huart3);
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel3);
+  return;
+#endif
+  /* USER CODE END DMA1_Channel3_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart3_rx);
+  /* USER CODE BEGIN DMA1_Channel3_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel3);
+  /* USER CODE END DMA1_Channel3_IRQn 1 */
+}
+
 /**
   * @brief This function handles DMA1 channel4 global interrupt.
   */
 void DMA1_Channel4_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Channel4_IRQn 0 */
-
+  CPU_PROFILE_IRQ_ENTER(DMA1_Channel4);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_tx_irq_handler(&huart1);
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel4);
+  return;
+#endif
   /* USER CODE END DMA1_Channel4_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_tx);
   /* USER CODE BEGIN DMA1_Channel4_IRQn 1 */
-
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel4);
   /* USER CODE END DMA1_Channel4_IRQn 1 */
 }
 
@@ -182,42 +235,156 @@ void DMA1_Channel4_IRQHandler(void)
 void DMA1_Channel5_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Channel5_IRQn 0 */
-
+  CPU_PROFILE_IRQ_ENTER(DMA1_Channel5);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_rx_irq_handler(&huart1);
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel5);
+  return;
+#endif
   /* USER CODE END DMA1_Channel5_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_rx);
   /* USER CODE BEGIN DMA1_Channel5_IRQn 1 */
-
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel5);
   /* USER CODE END DMA1_Channel5_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA1 channel6 global interrupt.
+  */
+void DMA1_Channel6_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel6_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(DMA1_Channel6);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_rx_irq_handler(&huart2);
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel6);
+  return;
+#endif
+  /* USER CODE END DMA1_Channel6_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart2_rx);
+  /* USER CODE BEGIN DMA1_Channel6_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel6);
+  /* USER CODE END DMA1_Channel6_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel7 global interrupt.
+  */
+void DMA1_Channel7_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel7_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(DMA1_Channel7);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_tx_irq_handler(&huart2);
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel7);
+  return;
+#endif
+  /* USER CODE END DMA1_Channel7_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart2_tx);
+  /* USER CODE BEGIN DMA1_Channel7_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(DMA1_Channel7);
+  /* USER CODE END DMA1_Channel7_IRQn 1 */
+}
+
 /**
   * @brief This function handles TIM1 update interrupt.
   */
 void TIM1_UP_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM1_UP_IRQn 0 */
-
+  CPU_PROFILE_IRQ_ENTER(TIM1_UP);
   /* USER CODE END TIM1_UP_IRQn 0 */
   HAL_TIM_IRQHandler(&htim1);
   /* USER CODE BEGIN TIM1_UP_IRQn 1 */
-
+  CPU_PROFILE_IRQ_EXIT(TIM1_UP);
   /* USER CODE END TIM1_UP_IRQn 1 */
 }
 
+/**
+  * @brief This function handles TIM2 global interrupt.
+  */
+void TIM2_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM2_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(TIM2);
+  /* USER CODE END TIM2_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim2);
+  /* USER CODE BEGIN TIM2_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(TIM2);
+  /* USER CODE END TIM2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles TIM3 global interrupt.
+  */
+void TIM3_IRQHandler(void)
+{
+  /* USER CODE BEGIN TIM3_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(TIM3);
+  /* USER CODE END TIM3_IRQn 0 */
+  HAL_TIM_IRQHandler(&htim3);
+  /* USER CODE BEGIN TIM3_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(TIM3);
+  /* USER CODE END TIM3_IRQn 1 */
+}
+
 /**
   * @brief This function handles USART1 global interrupt.
   */
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
-
+  CPU_PROFILE_IRQ_ENTER(USART1);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_usart_irq_handler(&huart1);
+  CPU_PROFILE_IRQ_EXIT(USART1);
+  return;
+#endif
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
-
+  CPU_PROFILE_IRQ_EXIT(USART1);
   /* USER CODE END USART1_IRQn 1 */
 }
 
+/**
+  * @brief This function handles USART2 global interrupt.
+  */
+void USART2_IRQHandler(void)
+{
+  /* USER CODE BEGIN USART2_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(USART2);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_usart_irq_handler(&huart2);
+  CPU_PROFILE_IRQ_EXIT(USART2);
+  return;
+#endif
+  /* USER CODE END USART2_IRQn 0 */
+  HAL_UART_IRQHandler(&huart2);
+  /* USER CODE BEGIN USART2_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(USART2);
+  /* USER CODE END USART2_IRQn 1 */
+}
+
+/**
+  * @brief This function handles USART3 global interrupt.
+  */
+void USART3_IRQHandler(void)
+{
+  /* USER CODE BEGIN USART3_IRQn 0 */
+  CPU_PROFILE_IRQ_ENTER(USART3);
+#if UART_DMA_BACKEND_LL
+  uart_dma_ll_usart_irq_handler(&huart3);
+  CPU_PROFILE_IRQ_EXIT(USART3);
+  return;
+#endif
+  /* USER CODE END USART3_IRQn 0 */
+  HAL_UART_IRQHandler(&huart3);
+  /* USER CODE BEGIN USART3_IRQn 1 */
+  CPU_PROFILE_IRQ_EXIT(USART3);
+  /* USER CODE END USART3_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */
@@ -0,0 +1,277 @@
+/*
+ * uart_dma_ll.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include <uart_dma_ll.h>
+#include "stm32f1xx_ll_dma.h"
+#include "stm32f1xx_ll_usart.h"
+
+#define UART_DMA_LL_CHANNELS 7
+
+/**
+ * @brief Ping-pong state of one TX channel.
+ */
+typedef struct {
+	const uint8_t* data;    /**< Armed next block */
+	uint16_t size;          /**< Armed next block size, 0 if none */
+	uint16_t chained;       /**< Size of the block started from the last TC */
+} uart_dma_ll_next_t;
+
+static uart_dma_ll_next_t uart_dma_ll_tx_next[UART_DMA_LL_CHANNELS];
+
+/**
+ * @brief Get the LL channel number of a HAL DMA handle.
+ *
+ * HAL stores the channel as a flag shift, four flag bits per channel.
+ */
+static inline uint32_t uart_dma_ll_channel(const DMA_HandleTypeDef* hdma)
+{
+	return (hdma->ChannelIndex >> 2) + LL_DMA_CHANNEL_1;
+}
+
+/**
+ * @brief Take the channel offline and clear its pending flags.
+ */
+static inline void uart_dma_ll_channel_reset(DMA_HandleTypeDef* hdma, uint32_t channel)
+{
+	LL_DMA_DisableChannel(hdma->DmaBaseAddress, channel);
+	hdma->DmaBaseAddress->IFCR = DMA_IFCR_CGIF1 << hdma->ChannelIndex;
+}
+
+/**
+ * @brief Program and enable a memory to USART transfer.
+ */
+static inline void uart_dma_ll_tx_start(UART_HandleTypeDef* huart, DMA_HandleTypeDef* hdma, uint32_t channel,
+		const uint8_t* data, uint16_t size)
+{
+	DMA_TypeDef* dma = hdma->DmaBaseAddress;
+
+	uart_dma_ll_channel_reset(hdma, channel);
+	LL_DMA_SetMemoryAddress(dma, channel, (uint32_t)data);
+	LL_DMA_SetPeriphAddress(dma, channel, LL_USART_DMA_GetRegAddr(huart->Instance));
+	LL_DMA_SetDataLength(dma, channel, size);
+	LL_DMA_EnableIT_TC(dma, channel);
+	LL_DMA_EnableIT_TE(dma, channel);
+
+	// TC stays set from the last idle period, clear it so it reports
+	// the end of this transfer on the line, see uart_dma_ll_tx_is_idle()
+	LL_USART_ClearFlag_TC(huart->Instance);
+	LL_DMA_EnableChannel(dma, channel);
+}
+
+/**
+ * @brief Start a memory to USART DMA transfer.
+ * @param huart Pointer to UART handle with linked TX DMA handle.
+ * @param data Source buffer.
+ * @param size Number of bytes, non-zero.
+ * @return HAL_OK if started, HAL_ERROR on invalid size.
+ */
+HAL_StatusTypeDef uart_dma_ll_transmit(UART_HandleTypeDef* huart, const uint8_t* data, uint16_t size)
+{
+	DMA_HandleTypeDef* hdma = huart->hdmatx;
+
+	if (size == 0)
+		return HAL_ERROR;
+
+	uart_dma_ll_tx_start(huart, hdma, uart_dma_ll_channel(hdma), data, size);
+
+	// DMAT stays set between transfers, the pending TXE request
+	// starts the channel as soon as it is enabled
+	LL_USART_EnableDMAReq_TX(huart->Instance);
+	return HAL_OK;
+}
+
+/**
+ * @brief Arm the block to transmit right after the current one (ping-pong).
+ * @param huart Pointer to UART handle with linked TX DMA handle.
+ * @param data Source buffer.
+ * @param size Number of bytes, 0 to disarm.
+ */
+void uart_dma_ll_set_next(UART_HandleTypeDef* huart, const uint8_t* data, uint16_t size)
+{
+	uart_dma_ll_next_t* next = &uart_dma_ll_tx_next[huart->hdmatx->ChannelIndex >> 2];
+
+	next->data = data;
+	next->size = size;
+}
+
+/**
+ * @brief Get and clear the size of the block chained at the last TC.
+ * @param huart Pointer to UART handle with linked TX DMA handle.
+ * @return Size of the chained block, 0 if the channel stopped.
+ */
+uint16_t uart_dma_ll_take_chained(UART_HandleTypeDef* huart)
+{
+	uart_dma_ll_next_t* next = &uart_dma_ll_tx_next[huart->hdmatx->ChannelIndex >> 2];
+	uint16_t chained = next->chained;
+
+	next->chained = 0;
+	return chained;
+}
+
+/**
+ * @brief Check whether the USART has shifted out the last transmitted byte.
+ * @param huart Pointer to UART handle.
+ * @return Non-zero once the line is idle.
+ */
+int uart_dma_ll_tx_is_idle(UART_HandleTypeDef* huart)
+{
+	return LL_USART_IsActiveFlag_TC(huart->Instance);
+}
+
+/**
+ * @brief Start USART to memory DMA reception with IDLE line detection.
+ * @param huart Pointer to UART handle with linked RX DMA handle.
+ * @param data Destination buffer.
+ * @param size Buffer size in bytes, non-zero.
+ * @return HAL_OK if started, HAL_ERROR on invalid size.
+ */
+HAL_StatusTypeDef uart_dma_ll_receive_to_idle(UART_HandleTypeDef* huart, uint8_t* data, uint16_t size)
+{
+	DMA_HandleTypeDef* hdma = huart->hdmarx;
+	DMA_TypeDef* dma = hdma->DmaBaseAddress;
+	uint32_t channel = uart_dma_ll_channel(hdma);
+
+	if (size == 0)
+		return HAL_ERROR;
+
+	uart_dma_ll_channel_reset(hdma, channel);
+	LL_DMA_SetMemoryAddress(dma, channel, (uint32_t)data);
+	LL_DMA_SetPeriphAddress(dma, channel, LL_USART_DMA_GetRegAddr(huart->Instance));
+	LL_DMA_SetDataLength(dma, channel, size);
+	LL_DMA_EnableIT_HT(dma, channel);
+	LL_DMA_EnableIT_TC(dma, channel);
+	LL_DMA_EnableIT_TE(dma, channel);
+
+	// HAL is bypassed, its transfer size field holds ours
+	huart->RxXferSize = size;
+	LL_DMA_EnableChannel(dma, channel);
+	LL_USART_EnableDMAReq_RX(huart->Instance);
+
+	// Same order as HAL: a stale IDLE flag must not report an empty event
+	LL_USART_ClearFlag_IDLE(huart->Instance);
+	LL_USART_EnableIT_IDLE(huart->Instance);
+
+	// Reception errors are counted, DMA is not stopped for them
+	if (huart->Init.Parity != UART_PARITY_NONE)
+		LL_USART_EnableIT_PE(huart->Instance);
+	LL_USART_EnableIT_ERROR(huart->Instance);
+	return HAL_OK;
+}
+
+/**
+ * @brief Check whether the RX DMA channel still has room to receive.
+ * @param huart Pointer to UART handle.
+ * @return Non-zero if the channel is enabled and not exhausted.
+ */
+int uart_dma_ll_rx_is_active(UART_HandleTypeDef* huart)
+{
+	DMA_HandleTypeDef* hdma = huart->hdmarx;
+	uint32_t channel = uart_dma_ll_channel(hdma);
+
+	return LL_DMA_IsEnabledChannel(hdma->DmaBaseAddress, channel) &&
+		LL_DMA_GetDataLength(hdma->DmaBaseAddress, channel) != 0;
+}
+
+/**
+ * @brief TX DMA channel interrupt handler.
+ * @param huart Pointer to UART handle owning the channel.
+ */
+void uart_dma_ll_tx_irq_handler(UART_HandleTypeDef* huart)
+{
+	DMA_HandleTypeDef* hdma = huart->hdmatx;
+	uint32_t flags = hdma->DmaBaseAddress->ISR >> hdma->ChannelIndex;
+
+	if ((flags & (DMA_ISR_TCIF1 | DMA_ISR_TEIF1)) == 0)
+		return;
+
+	uint32_t channel = uart_dma_ll_channel(hdma);
+	uart_dma_ll_next_t* next = &uart_dma_ll_tx_next[hdma->ChannelIndex >> 2];
+
+	if (next->size != 0 && !(flags & DMA_ISR_TEIF1)) {
+		// Ping-pong: re-arm first, DR and the shift register still
+		// hold up to two bytes, so the line does not go idle
+		uart_dma_ll_tx_start(huart, hdma, channel, next->data, next->size);
+		next->chained = next->size;
+	} else {
+		uart_dma_ll_channel_reset(hdma, channel);
+		next->chained = 0;
+	}
+	next->size = 0;
+
+	// A transfer error also ends the transfer: report it complete so the
+	// ring space is released and the channel owner moves on
+	HAL_UART_TxCpltCallback(huart);
+}
+
+/**
+ * @brief RX DMA channel interrupt handler.
+ * @param huart Pointer to UART handle owning the channel.
+ */
+void uart_dma_ll_rx_irq_handler(UART_HandleTypeDef* huart)
+{
+	DMA_HandleTypeDef* hdma = huart->hdmarx;
+	DMA_TypeDef* dma = hdma->DmaBaseAddress;
+	uint32_t channel = uart_dma_ll_channel(hdma);
+	uint32_t flags = dma->ISR >> hdma->ChannelIndex;
+
+	dma->IFCR = (flags & (DMA_ISR_HTIF1 | DMA_ISR_TCIF1 | DMA_ISR_TEIF1)) << hdma->ChannelIndex;
+
+	if (flags & DMA_ISR_TEIF1) {
+		// Hardware disables the channel on error, circular mode included.
+		// Like HAL, report it as an error: the callback commits what
+		// arrived and restarts reception, nothing else would.
+		LL_DMA_DisableChannel(dma, channel);
+		huart->ErrorCode |= HAL_UART_ERROR_DMA;
+		HAL_UART_ErrorCallback(huart);
+		return;
+	} else if ((flags & (DMA_ISR_HTIF1 | DMA_ISR_TCIF1)) == 0) {
+		return;
+	} else if ((flags & DMA_ISR_TCIF1) && hdma->Init.Mode != DMA_CIRCULAR) {
+		// Exhausted normal transfer, the channel is reprogrammed on restart
+		LL_DMA_DisableChannel(dma, channel);
+	}
+
+	huart->RxEventType = (flags & DMA_ISR_TCIF1) ? HAL_UART_RXEVENT_TC : HAL_UART_RXEVENT_HT;
+	HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize - LL_DMA_GetDataLength(dma, channel));
+}
+
+/**
+ * @brief USART interrupt handler (IDLE line detection, reception errors).
+ *
+ * Errors are reported through HAL_UART_ErrorCallback() with huart->ErrorCode
+ * set, RX DMA keeps running.
+ *
+ * @param huart Pointer to UART handle.
+ */
+void uart_dma_ll_usart_irq_handler(UART_HandleTypeDef* huart)
+{
+	USART_TypeDef* usart = huart->Instance;
+	DMA_HandleTypeDef* hdma = huart->hdmarx;
+	uint32_t status = usart->SR;
+
+	if ((status & (USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE)) && LL_USART_IsEnabledIT_ERROR(usart)) {
+		// Flags clear on the DR read following the SR read. While RXNE is
+		// set the byte belongs to DMA and its read clears them, unless the
+		// channel is stopped and nobody would read it.
+		if (!(status & USART_SR_RXNE) || !uart_dma_ll_rx_is_active(huart))
+			(void)usart->DR;
+
+		huart->ErrorCode |= ((status & USART_SR_PE) ? HAL_UART_ERROR_PE : 0) |
+			((status & USART_SR_FE) ? HAL_UART_ERROR_FE : 0) |
+			((status & USART_SR_NE) ? HAL_UART_ERROR_NE : 0) |
+			((status & USART_SR_ORE) ? HAL_UART_ERROR_ORE : 0);
+		HAL_UART_ErrorCallback(huart);
+	}
+
+	if (!(status & USART_SR_IDLE) || !LL_USART_IsEnabledIT_IDLE(usart))
+		return;
+
+	LL_USART_ClearFlag_IDLE(usart);
+	huart->RxEventType = HAL_UART_RXEVENT_IDLE;
+	HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize -
+		LL_DMA_GetDataLength(hdma->DmaBaseAddress, uart_dma_ll_channel(hdma)));
+}
@@ -0,0 +1,58 @@
+/*
+ * uart_trace.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ */
+
+#include <uart_trace.h>
+
+#if UART_TRACE
+#include <stddef.h>
+
+_Static_assert(offsetof(uart_trace_t, ports) == UART_TRACE_HEADER_SIZE &&
+		sizeof(uart_trace_port_t) == UART_TRACE_PORT_SIZE &&
+		sizeof(uart_trace_record_t) == 8 &&
+		offsetof(uart_trace_t, records) == UART_TRACE_HEADER_SIZE + UART_PORT_COUNT * UART_TRACE_PORT_SIZE,
+		"uart_trace_t layout must match the dump format");
+
+#define UART_TRACE_PORT(name, handle, usart, baud, tx_size, rx_size, tim_channel, rx_tim_channel) \
+	[UART_PORT_##name] = { #name, (baud) },
+
+uart_trace_t uart_trace = {
+	.magic = UART_TRACE_MAGIC,
+	.version = UART_TRACE_VERSION,
+	.port_count = UART_PORT_COUNT,
+	.size = UART_TRACE_SIZE,
+	.ports = { UART_PORTS(UART_TRACE_PORT) },
+};
+
+/**
+ * @brief Clear the trace buffer and start recording.
+ *
+ * Enables the DWT cycle counter.
+ */
+void uart_trace_start(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	uart_trace.enabled = 0;
+	uart_trace.cpu_hz = SystemCoreClock;
+	uart_trace.written = 0;
+	__atomic_store_n(&uart_trace.enabled, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Stop recording, the buffer can be dumped afterwards.
+ * @param size Receives the dump size in bytes, may be NULL.
+ * @return Start of the dump.
+ */
+const uint8_t* uart_trace_stop(size_t* size)
+{
+	__atomic_store_n(&uart_trace.enabled, 0, __ATOMIC_RELEASE);
+	if (size != NULL)
+		*size = offsetof(uart_trace_t, enabled);
+	return (const uint8_t*)&uart_trace;
+}
+#endif
@@ -0,0 +1,76 @@
+/*
+ * baud_calc.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Baud rate and RX ring calculator, same arithmetic as the firmware's
+ * compile-time checks (Core/Inc/uart_baud.h). For each baud rate prints
+ * the programmed BRR, the actual rate and its error, the smallest RX ring
+ * for the given latency budget and the longest latency the given ring
+ * tolerates.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -ICore/Inc Tools/ring_bench/baud_calc.c -o baud_calc && ./baud_calc [options] [baud...]
+ *
+ * Options:
+ *   --pclk N        USART clock in Hz (default 72000000, USART1 on PCLK2)
+ *   --ring N        RX ring size in bytes (default 1024)
+ *   --latency N     reader latency budget in us (default 1000)
+ */
+
+#include <uart_baud.h>
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+int main(int argc, char** argv)
+{
+	static const unsigned long default_bauds[] = {
+		19200, 115200, 460800, 921600, 1000000, 2000000, 2250000, 3000000, 3600000, 4500000,
+	};
+	unsigned long bauds[32];
+	size_t count = 0;
+	unsigned long pclk = 72000000, ring = 1024, latency = 1000;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--pclk") == 0)
+			pclk = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--ring") == 0)
+			ring = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--latency") == 0)
+			latency = parse_arg(argc, argv, &i);
+		else if (argv[i][0] == '-') {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		} else if (count < sizeof(bauds)/sizeof(bauds[0])) {
+			bauds[count++] = strtoul(argv[i], NULL, 0);
+		}
+	}
+	if (count == 0) {
+		memcpy(bauds, default_bauds, sizeof(default_bauds));
+		count = sizeof(default_bauds)/sizeof(default_bauds[0]);
+	}
+
+	printf("baud,brr,actual,error_ppm,valid,min_rx_ring,max_latency_us,ring_ok\n");
+	for (size_t i = 0; i < count; i++) {
+		unsigned long baud = bauds[i];
+		if (baud == 0 || (uint64_t)pclk < (uint64_t)baud * UART_BRR_MIN) {
+			printf("%lu,,,,0,,,0\n", baud);
+			continue;
+		}
+
+		uint64_t min_ring = UART_RX_RING_MIN_SIZE(baud, latency);
+		printf("%lu,%llu,%llu,%llu,%d,%llu,%llu,%d\n", baud,
+			(unsigned long long)UART_BRR_VALUE(pclk, baud),
+			(unsigned long long)UART_BAUD_ACTUAL(pclk, baud),
+			(unsigned long long)UART_BAUD_ERROR_PPM(pclk, baud),
+			UART_BAUD_IS_VALID(pclk, baud) ? 1 : 0,
+			(unsigned long long)min_ring,
+			(unsigned long long)UART_RX_LATENCY_LIMIT_US(baud, ring),
+			ring >= min_ring);
+	}
+	return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * cpu_profile_decode.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Decoder for CPU_PROFILE snapshots (cpu_profile_snapshot(), format in
+ * Core/Inc/cpu_profile.h). Reads a capture file or stdin, finds every
+ * snapshot in it by its magic, so a raw serial capture with other traffic
+ * around the snapshots works, and prints one CSV block per snapshot: CPU
+ * cycles per task and per interrupt handler, with their share of wall
+ * time since reset (tick count). CYCCNT stops while the core sleeps,
+ * wall time not covered by any entry is reported as "sleep".
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -ICore/Inc Tools/ring_bench/cpu_profile_decode.c -o cpu_profile_decode
+ *   ./cpu_profile_decode [--delta] [capture.bin]
+ *
+ * Options:
+ *   --delta     print each snapshot after the first as the difference to
+ *               the previous one (load over the interval between them)
+ */
+
+#include <cpu_profile.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DECODE_MAX_ENTRIES  64
+#define DECODE_NAME_MAX     32
+
+typedef struct {
+	char name[DECODE_NAME_MAX + 1];
+	int irq;
+	uint64_t cycles;
+	uint32_t count;         // switches in for tasks
+	uint32_t max;
+} decode_entry_t;
+
+typedef struct {
+	uint32_t cpu_hz;
+	uint32_t tick_hz;
+	uint32_t ticks;
+	uint32_t untracked;
+	size_t entry_count;
+	decode_entry_t entries[DECODE_MAX_ENTRIES];
+} decode_snapshot_t;
+
+static uint32_t get_u32(const uint8_t* p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t get_u64(const uint8_t* p)
+{
+	return (uint64_t)get_u32(p) | (uint64_t)get_u32(p + 4) << 32;
+}
+
+/**
+ * @brief Parse one snapshot.
+ * @return Snapshot length, 0 if @p data does not start with a valid one.
+ */
+static size_t decode_snapshot(const uint8_t* data, size_t size, decode_snapshot_t* s)
+{
+	if (size < CPU_PROFILE_HEADER_SIZE || get_u32(data) != CPU_PROFILE_MAGIC || data[4] != CPU_PROFILE_VERSION)
+		return 0;
+
+	size_t name_length = data[5], tasks = data[6], irqs = data[7];
+	size_t length = CPU_PROFILE_HEADER_SIZE + tasks * CPU_PROFILE_TASK_SIZE(name_length)
+			+ irqs * CPU_PROFILE_IRQ_SIZE(name_length);
+	if (name_length == 0 || name_length > DECODE_NAME_MAX || tasks + irqs > DECODE_MAX_ENTRIES || length > size)
+		return 0;
+
+	s->cpu_hz = get_u32(data + 8);
+	s->tick_hz = get_u32(data + 12);
+	s->ticks = get_u32(data + 16);
+	s->untracked = get_u32(data + 20);
+	s->entry_count = tasks + irqs;
+
+	const uint8_t* p = data + CPU_PROFILE_HEADER_SIZE;
+	for (size_t i = 0; i < s->entry_count; i++) {
+		decode_entry_t* e = &s->entries[i];
+		memcpy(e->name, p, name_length);
+		e->name[name_length] = '\0';
+		p += name_length;
+		e->irq = i >= tasks;
+		e->cycles = get_u64(p);
+		e->count = get_u32(p + 8);
+		e->max = e->irq ? get_u32(p + 12) : 0;
+		p += e->irq ? 16 : 12;
+	}
+	return length;
+}
+
+static const decode_entry_t* find_entry(const decode_snapshot_t* s, const decode_entry_t* e)
+{
+	for (size_t i = 0; i < s->entry_count; i++)
+		if (s->entries[i].irq == e->irq && strcmp(s->entries[i].name, e->name) == 0)
+			return &s->entries[i];
+	return NULL;
+}
+
+static void print_snapshot(unsigned index, const decode_snapshot_t* s, const decode_snapshot_t* previous)
+{
+	uint32_t ticks = s->ticks - (previous ? previous->ticks : 0);
+	double wall = s->tick_hz ? (double)ticks * s->cpu_hz / s->tick_hz : 0.0;
+	uint64_t awake = 0;
+
+	for (size_t i = 0; i < s->entry_count; i++) {
+		decode_entry_t e = s->entries[i];
+		const decode_entry_t* old = previous ? find_entry(previous, &e) : NULL;
+		if (old != NULL) {
+			e.cycles -= old->cycles;
+			e.count -= old->count;
+		}
+		awake += e.cycles;
+		printf("%u,%s,%s,%llu,%.4f,%u,%.0f,", index, e.irq ? "irq" : "task", e.name,
+			(unsigned long long)e.cycles, wall > 0 ? e.cycles / wall : 0.0, e.count,
+			e.count ? (double)e.cycles / e.count : 0.0);
+		if (e.irq)
+			printf("%u\n", e.max);
+		else
+			printf("\n");
+	}
+	// Ticks come from the same clock, the difference is time asleep
+	printf("%u,sleep,,%.0f,%.4f,,,\n", index, wall > awake ? wall - awake : 0.0,
+		wall > awake ? (wall - awake) / wall : 0.0);
+	printf("%u,wall,,%.0f,1.0000,%u,,\n", index, wall, ticks);
+	if (s->untracked)
+		printf("%u,untracked,,,,%u,,\n", index, s->untracked - (previous ? previous->untracked : 0));
+}
+
+int main(int argc, char** argv)
+{
+	const char* path = NULL;
+	int delta = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--delta") == 0)
+			delta = 1;
+		else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		} else
+			path = argv[i];
+	}
+
+	FILE* f = (path == NULL || strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+	if (f == NULL) {
+		perror(path);
+		return 2;
+	}
+	size_t size = 0, capacity = 1 << 16;
+	uint8_t* data = malloc(capacity);
+	size_t n;
+	while (data != NULL && (n = fread(data + size, 1, capacity - size, f)) > 0) {
+		size += n;
+		if (size == capacity)
+			data = realloc(data, capacity *= 2);
+	}
+	if (f != stdin)
+		fclose(f);
+	if (data == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 2;
+	}
+
+	static decode_snapshot_t snapshots[2];
+	unsigned count = 0;
+
+	printf("snapshot,kind,name,cycles,share,count,avg_cycles,max_cycles\n");
+	for (size_t offset = 0; offset < size; ) {
+		decode_snapshot_t* s = &snapshots[count & 1];
+		size_t length = decode_snapshot(data + offset, size - offset, s);
+		if (length == 0) {
+			offset++;
+			continue;
+		}
+		print_snapshot(count, s, delta && count > 0 ? &snapshots[(count - 1) & 1] : NULL);
+		count++;
+		offset += length;
+	}
+	free(data);
+
+	if (count == 0) {
+		fprintf(stderr, "no snapshot found\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * echo_bench.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Aggregate throughput benchmark of the echo firmware: saturates every
+ * given serial port at once with a sequence pattern, checks the echoed
+ * stream byte by byte and reports per port and total echoed throughput
+ * against the line rate.
+ *
+ * Each port keeps at most --window bytes in flight, below the RX/TX ring
+ * sizes, so the line stays busy without the firmware ever having to drop
+ * data. Connect one USB-serial adapter per USART (USART1 PA9/PA10,
+ * USART2 PA2/PA3, USART3 PB10/PB11).
+ *
+ * Build and run from repository root (Linux):
+ *   gcc -O2 Tools/ring_bench/echo_bench.c -o echo_bench && \
+ *       ./echo_bench [options] /dev/ttyUSB0 /dev/ttyUSB1 /dev/ttyUSB2
+ *
+ * Options:
+ *   --baud N       line rate of all ports (default 19200)
+ *   --seconds N    measurement duration (default 10)
+ *   --window N     maximum unechoed bytes per port (default 512)
+ *
+ * At most 8 ports (BENCH_MAX_PORTS).
+ */
+
+#include "tool_args.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_MAX_PORTS    8
+#define BENCH_BITS_PER_CHAR 10
+
+typedef struct {
+	const char* path;
+	int fd;
+	uint64_t sent;          /* bytes written, also the next pattern index */
+	uint64_t echoed;        /* bytes read back */
+	uint64_t errors;        /* echoed bytes not matching the pattern */
+} bench_port_t;
+
+static inline uint8_t bench_pattern(uint64_t index)
+{
+	return (uint8_t)(index * 131 + (index >> 8));
+}
+
+static speed_t bench_speed(unsigned long baud)
+{
+	switch (baud) {
+	case 9600: return B9600;
+	case 19200: return B19200;
+	case 38400: return B38400;
+	case 57600: return B57600;
+	case 115200: return B115200;
+	case 230400: return B230400;
+	case 460800: return B460800;
+	case 921600: return B921600;
+	case 1000000: return B1000000;
+	case 2000000: return B2000000;
+	case 3000000: return B3000000;
+	case 4000000: return B4000000;
+	default: return 0;
+	}
+}
+
+static int bench_open(bench_port_t* p, speed_t speed)
+{
+	struct termios tio;
+
+	p->fd = open(p->path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (p->fd < 0 || tcgetattr(p->fd, &tio) != 0) {
+		fprintf(stderr, "%s: %s\n", p->path, strerror(errno));
+		return -1;
+	}
+
+	// 8N1, raw, no flow control, same as the firmware defaults
+	cfmakeraw(&tio);
+	tio.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+	tio.c_cflag |= CLOCAL | CREAD;
+	cfsetispeed(&tio, speed);
+	cfsetospeed(&tio, speed);
+	if (tcsetattr(p->fd, TCSANOW, &tio) != 0) {
+		fprintf(stderr, "%s: %s\n", p->path, strerror(errno));
+		return -1;
+	}
+	tcflush(p->fd, TCIOFLUSH);
+	return 0;
+}
+
+static double bench_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv)
+{
+	bench_port_t ports[BENCH_MAX_PORTS];
+	struct pollfd fds[BENCH_MAX_PORTS];
+	unsigned long baud = 19200, seconds = 10, window = 512;
+	size_t count = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--baud") == 0)
+			baud = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--seconds") == 0)
+			seconds = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--window") == 0)
+			window = parse_arg(argc, argv, &i);
+		else if (argv[i][0] == '-') {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		} else if (count == BENCH_MAX_PORTS) {
+			fprintf(stderr, "at most %d ports\n", BENCH_MAX_PORTS);
+			return 2;
+		} else {
+			memset(&ports[count], 0, sizeof(ports[count]));
+			ports[count++].path = argv[i];
+		}
+	}
+
+	speed_t speed = bench_speed(baud);
+	if (count == 0 || speed == 0 || window == 0) {
+		fprintf(stderr, "usage: %s [--baud N] [--seconds N] [--window N] tty...\n", argv[0]);
+		return 2;
+	}
+	for (size_t i = 0; i < count; i++) {
+		if (bench_open(&ports[i], speed) != 0)
+			return 1;
+		fds[i].fd = ports[i].fd;
+	}
+
+	double start = bench_now();
+	double end = start + seconds;
+	uint8_t buffer[4096];
+
+	while (bench_now() < end) {
+		for (size_t i = 0; i < count; i++) {
+			bench_port_t* p = &ports[i];
+			fds[i].events = POLLIN;
+			if (p->sent - p->echoed < window)
+				fds[i].events |= POLLOUT;
+		}
+		if (poll(fds, count, 100) < 0 && errno != EINTR) {
+			perror("poll");
+			return 1;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			bench_port_t* p = &ports[i];
+
+			if (fds[i].revents & POLLIN) {
+				ssize_t n = read(p->fd, buffer, sizeof(buffer));
+				for (ssize_t k = 0; k < n; k++) {
+					if (buffer[k] != bench_pattern(p->echoed + k))
+						p->errors++;
+				}
+				if (n > 0)
+					p->echoed += n;
+			}
+
+			if (fds[i].revents & POLLOUT) {
+				size_t len = window - (p->sent - p->echoed);
+				if (len > sizeof(buffer))
+					len = sizeof(buffer);
+				for (size_t k = 0; k < len; k++)
+					buffer[k] = bench_pattern(p->sent + k);
+				ssize_t n = write(p->fd, buffer, len);
+				if (n > 0)
+					p->sent += n;
+			}
+		}
+	}
+
+	double elapsed = bench_now() - start;
+	double line_rate = (double)baud / BENCH_BITS_PER_CHAR;
+	uint64_t total = 0, total_errors = 0;
+
+	printf("port,echoed_bytes,bytes_per_s,line_utilization,errors\n");
+	for (size_t i = 0; i < count; i++) {
+		bench_port_t* p = &ports[i];
+		printf("%s,%llu,%.0f,%.4f,%llu\n", p->path,
+			(unsigned long long)p->echoed,
+			p->echoed / elapsed,
+			p->echoed / elapsed / line_rate,
+			(unsigned long long)p->errors);
+		total += p->echoed;
+		total_errors += p->errors;
+		close(p->fd);
+	}
+	printf("total,%llu,%.0f,%.4f,%llu\n",
+		(unsigned long long)total, total / elapsed,
+		total / elapsed / (line_rate * count),
+		(unsigned long long)total_errors);
+
+	return total_errors == 0 ? 0 : 1;
+}
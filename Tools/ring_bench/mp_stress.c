@@ -0,0 +1,149 @@
+/*
+ * mp_stress.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Host stress test for mp_ring_buffer_t: several producer threads enqueue
+ * variable length records concurrently while one consumer drains the ring
+ * like TX DMA does. The consumer checks that every record arrives whole,
+ * uninterleaved and in per-producer order.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -pthread -ICore/Inc Core/Src/ring_copy.c Core/Src/mp_ring_buffer.c \
+ *       Tools/ring_bench/mp_stress.c -o mp_stress && ./mp_stress [records per producer]
+ */
+
+#include <mp_ring_buffer.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define STRESS_RING_SIZE 1024
+#define STRESS_PRODUCERS 4
+#define STRESS_MAX_PAYLOAD 120
+#define STRESS_HEADER_SIZE 6
+
+static uint8_t ring_storage[STRESS_RING_SIZE];
+static mp_ring_buffer_t ring;
+static uint32_t records_per_producer;
+
+typedef struct {
+	uint8_t id;
+	uint32_t seed;
+} producer_t;
+
+static inline uint32_t stress_random(uint32_t* state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+// Record: [payload length][producer id][sequence, 4 bytes][payload]
+static void* producer_thread(void* arg)
+{
+	producer_t* p = arg;
+	uint8_t record[STRESS_HEADER_SIZE + STRESS_MAX_PAYLOAD];
+
+	for (uint32_t seq = 0; seq < records_per_producer; seq++) {
+		uint8_t len = stress_random(&p->seed) % STRESS_MAX_PAYLOAD;
+		record[0] = len;
+		record[1] = p->id;
+		memcpy(&record[2], &seq, sizeof(seq));
+		for (uint8_t i = 0; i < len; i++)
+			record[STRESS_HEADER_SIZE + i] = (uint8_t)(seq + i + p->id);
+
+		uint32_t start;
+		size_t size = STRESS_HEADER_SIZE + len;
+		while (mp_ring_buffer_reserve(&ring, size, &start) != 0)
+			sched_yield();
+
+		// Get preempted inside the reservation now and then, so other
+		// producers reserve and commit around a half-written record
+		mp_ring_buffer_copy_in(&ring, start, record, size / 2);
+		if ((stress_random(&p->seed) & 7) == 0)
+			sched_yield();
+		mp_ring_buffer_copy_in(&ring, start + size / 2, record + size / 2, size - size / 2);
+		mp_ring_buffer_commit(&ring);
+	}
+	return NULL;
+}
+
+// Drains the ring in linear blocks, like the TX DMA completion path
+static size_t consume(uint8_t* dst, size_t len)
+{
+	size_t copied = 0;
+	while (copied < len) {
+		uint8_t* data;
+		size_t block = mp_ring_buffer_peek_linear(&ring, &data);
+		if (block == 0) {
+			sched_yield();
+			continue;
+		}
+		if (block > len - copied)
+			block = len - copied;
+		memcpy(dst + copied, data, block);
+		mp_ring_buffer_release(&ring, block);
+		copied += block;
+	}
+	return copied;
+}
+
+int main(int argc, char** argv)
+{
+	pthread_t threads[STRESS_PRODUCERS];
+	producer_t producers[STRESS_PRODUCERS];
+	uint32_t expected_seq[STRESS_PRODUCERS] = { 0 };
+	uint8_t record[STRESS_HEADER_SIZE + STRESS_MAX_PAYLOAD];
+	uint64_t errors = 0;
+
+	records_per_producer = argc > 1 ? strtoul(argv[1], NULL, 0) : 200000;
+	mp_ring_buffer_init(&ring, ring_storage, STRESS_RING_SIZE);
+
+	for (int i = 0; i < STRESS_PRODUCERS; i++) {
+		producers[i].id = i;
+		producers[i].seed = 0x1234567u * (i + 1);
+		pthread_create(&threads[i], NULL, producer_thread, &producers[i]);
+	}
+
+	for (uint64_t n = 0; n < (uint64_t)records_per_producer * STRESS_PRODUCERS; n++) {
+		uint32_t seq;
+		consume(record, STRESS_HEADER_SIZE);
+		uint8_t len = record[0];
+		uint8_t id = record[1];
+		memcpy(&seq, &record[2], sizeof(seq));
+
+		if (len >= STRESS_MAX_PAYLOAD || id >= STRESS_PRODUCERS) {
+			fprintf(stderr, "corrupted header at record %llu\n", (unsigned long long)n);
+			return 1;
+		}
+		consume(record + STRESS_HEADER_SIZE, len);
+
+		if (seq != expected_seq[id]) {
+			if (errors++ == 0)
+				fprintf(stderr, "producer %u: got record %u, expected %u\n", id, seq, expected_seq[id]);
+		}
+		for (uint8_t i = 0; i < len; i++) {
+			if (record[STRESS_HEADER_SIZE + i] != (uint8_t)(seq + i + id)) {
+				if (errors++ == 0)
+					fprintf(stderr, "producer %u: record %u payload corrupted\n", id, seq);
+				break;
+			}
+		}
+		expected_seq[id] = seq + 1;
+	}
+
+	for (int i = 0; i < STRESS_PRODUCERS; i++)
+		pthread_join(threads[i], NULL);
+
+	printf("mp_ring %d producers x %u records, %llu errors\n",
+		STRESS_PRODUCERS, records_per_producer, (unsigned long long)errors);
+	return errors == 0 ? 0 : 1;
+}
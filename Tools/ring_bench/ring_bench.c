@@ -0,0 +1,570 @@
+/*
+ * ring_bench.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Host benchmark suite for the ring buffer hot path. The firmware sources
+ * are compiled unchanged, only the benchmark driver lives here.
+ *
+ * Every operation is timed per call over a grid of ring sizes, chunk sizes
+ * and wrap patterns:
+ *  - linear: operation starts at offset 0 and never crosses the buffer end,
+ *  - wrap:   operation straddles the buffer end,
+ *  - stream: offset advances by one chunk per call, like a real stream.
+ *
+ * Results are printed as CSV (default) or JSON lines, one row per case.
+ * A previous CSV run can be passed as baseline; cases whose median got
+ * slower than the tolerance are reported and the exit code is 1.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -ICore/Inc Core/Src/ring_buffer.c Core/Src/dma_ring_buffer.c \
+ *       Core/Src/ring_copy.c Core/Src/pow2_ring_buffer.c Core/Src/spsc_ring_buffer.c \
+ *       Tools/ring_bench/ring_bench.c -o ring_bench
+ *   ./ring_bench [--json] [--suite ring|pow2|spsc|copy] [--baseline old.csv] [--tolerance 10]
+ */
+
+#include <ring_buffer.h>
+#include <dma_ring_buffer.h>
+#include <pow2_ring_buffer.h>
+#include <spsc_ring_buffer.h>
+#include <ring_copy.h>
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MAX_RING_SIZE 4096
+#define BENCH_CALLS 4096
+#define BENCH_KEY_SIZE 64
+
+// Keep the compiler from folding or reordering the timed calls
+#define BENCH_BARRIER() __asm__ volatile("" : : : "memory")
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT "cycles"
+static inline uint64_t bench_timestamp(void)
+{
+	return __rdtsc();
+}
+#else
+#define BENCH_UNIT "ns"
+static inline uint64_t bench_timestamp(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+#endif
+
+typedef enum {
+	BENCH_PATTERN_LINEAR,
+	BENCH_PATTERN_WRAP,
+	BENCH_PATTERN_STREAM,
+	BENCH_PATTERN_COUNT
+} bench_pattern_t;
+
+static const char* const bench_pattern_names[BENCH_PATTERN_COUNT] = { "linear", "wrap", "stream" };
+
+typedef struct {
+	ring_buffer_t ring;
+	pow2_ring_buffer_t pow2;
+	spsc_ring_buffer_t spsc;
+	size_t ring_size;
+	uint8_t* chunk;
+} bench_ctx_t;
+
+/**
+ * @brief One benchmarked operation.
+ *
+ * prepare() puts the ring at @p offset holding @p used bytes outside the
+ * timed region, run() is the timed call.
+ */
+typedef struct {
+	const char* suite;
+	const char* op;
+	int needs_data;         /**< Ring must hold one chunk before the call */
+	void (*prepare)(bench_ctx_t* ctx, size_t offset, size_t used);
+	void (*run)(bench_ctx_t* ctx, size_t chunk);
+} bench_op_t;
+
+typedef struct {
+	const char* suite;
+	const char* op;
+	size_t ring_size;
+	size_t chunk;
+	const char* pattern;
+	double min, mean, p50, p99, max;
+	double mbytes_per_s;
+} bench_result_t;
+
+/**
+ * @brief Baseline median of one case, keyed by suite, op, sizes and pattern.
+ */
+typedef struct {
+	char key[BENCH_KEY_SIZE];
+	double p50;
+} bench_baseline_t;
+
+typedef struct {
+	int json;
+	const char* suite;
+	double tolerance;
+	bench_baseline_t* baseline;     /**< Rows in file order */
+	size_t baseline_count;
+	bench_baseline_t** index;       /**< Open addressing hash table over baseline */
+	size_t index_mask;
+	int regressions;
+} bench_options_t;
+
+static uint8_t ring_storage[BENCH_MAX_RING_SIZE];
+static uint8_t chunk_storage[BENCH_MAX_RING_SIZE];
+static uint64_t samples[BENCH_CALLS];
+static double timestamps_per_us;
+static uint64_t timestamp_overhead;
+
+static volatile size_t bench_sink;
+
+/* ring_buffer_t ------------------------------------------------------------*/
+
+static void ring_prepare(bench_ctx_t* ctx, size_t offset, size_t used)
+{
+	ring_buffer_t* rb = &ctx->ring;
+	rb->data = ring_storage;
+	rb->length = ctx->ring_size;
+	rb->head = offset;
+	rb->tail = (offset + used) % ctx->ring_size;
+	rb->available_size = ctx->ring_size - used;
+}
+
+static void ring_write(bench_ctx_t* ctx, size_t chunk)
+{
+	ring_buffer_write(&ctx->ring, ctx->chunk, (int)chunk);
+}
+
+static void ring_read(bench_ctx_t* ctx, size_t chunk)
+{
+	bench_sink = ring_buffer_read(&ctx->ring, ctx->chunk, chunk);
+}
+
+static void ring_produce(bench_ctx_t* ctx, size_t chunk)
+{
+	ring_buffer_produce(&ctx->ring, chunk);
+}
+
+static void ring_consume(bench_ctx_t* ctx, size_t chunk)
+{
+	ring_buffer_consume(&ctx->ring, chunk);
+}
+
+// TX completion path: account the finished transfer, size the next one
+static void ring_dma_tx(bench_ctx_t* ctx, size_t chunk)
+{
+	ring_buffer_produce(&ctx->ring, chunk);
+	bench_sink = get_size_to_produce_per_dma_operation(&ctx->ring);
+}
+
+// RX event path: commit received bytes, size the next transfer
+static void ring_dma_rx(bench_ctx_t* ctx, size_t chunk)
+{
+	ring_buffer_consume(&ctx->ring, chunk);
+	bench_sink = get_size_to_consume_per_dma_operation(&ctx->ring);
+}
+
+/* pow2_ring_buffer_t -------------------------------------------------------*/
+
+static void pow2_prepare(bench_ctx_t* ctx, size_t offset, size_t used)
+{
+	pow2_ring_buffer_init(&ctx->pow2, ring_storage, ctx->ring_size);
+	ctx->pow2.head = offset;
+	ctx->pow2.tail = offset + used;
+}
+
+static void pow2_write(bench_ctx_t* ctx, size_t chunk)
+{
+	pow2_ring_buffer_write(&ctx->pow2, ctx->chunk, chunk);
+}
+
+static void pow2_read(bench_ctx_t* ctx, size_t chunk)
+{
+	bench_sink = pow2_ring_buffer_read(&ctx->pow2, ctx->chunk, chunk);
+}
+
+static void pow2_produce(bench_ctx_t* ctx, size_t chunk)
+{
+	pow2_ring_buffer_produce(&ctx->pow2, chunk);
+}
+
+static void pow2_consume(bench_ctx_t* ctx, size_t chunk)
+{
+	pow2_ring_buffer_consume(&ctx->pow2, chunk);
+}
+
+static void pow2_dma_tx(bench_ctx_t* ctx, size_t chunk)
+{
+	pow2_ring_buffer_produce(&ctx->pow2, chunk);
+	bench_sink = pow2_ring_buffer_get_linear_used_size(&ctx->pow2);
+}
+
+static void pow2_dma_rx(bench_ctx_t* ctx, size_t chunk)
+{
+	pow2_ring_buffer_consume(&ctx->pow2, chunk);
+	bench_sink = pow2_ring_buffer_get_linear_free_size(&ctx->pow2);
+}
+
+/* spsc_ring_buffer_t -------------------------------------------------------*/
+
+static void spsc_prepare(bench_ctx_t* ctx, size_t offset, size_t used)
+{
+	spsc_ring_buffer_init(&ctx->spsc, ring_storage, ctx->ring_size);
+	atomic_store(&ctx->spsc.read_index, offset);
+	atomic_store(&ctx->spsc.write_index, offset + used);
+}
+
+static void spsc_write(bench_ctx_t* ctx, size_t chunk)
+{
+	spsc_ring_buffer_write(&ctx->spsc, ctx->chunk, chunk);
+}
+
+static void spsc_read(bench_ctx_t* ctx, size_t chunk)
+{
+	bench_sink = spsc_ring_buffer_read(&ctx->spsc, ctx->chunk, chunk);
+}
+
+static void spsc_produce(bench_ctx_t* ctx, size_t chunk)
+{
+	spsc_ring_buffer_commit_read(&ctx->spsc, chunk);
+}
+
+static void spsc_consume(bench_ctx_t* ctx, size_t chunk)
+{
+	spsc_ring_buffer_commit_write(&ctx->spsc, chunk);
+}
+
+static const bench_op_t bench_ops[] = {
+	{ "ring", "write",   0, ring_prepare, ring_write },
+	{ "ring", "read",    1, ring_prepare, ring_read },
+	{ "ring", "produce", 1, ring_prepare, ring_produce },
+	{ "ring", "consume", 0, ring_prepare, ring_consume },
+	{ "ring", "dma_tx",  1, ring_prepare, ring_dma_tx },
+	{ "ring", "dma_rx",  0, ring_prepare, ring_dma_rx },
+	{ "pow2", "write",   0, pow2_prepare, pow2_write },
+	{ "pow2", "read",    1, pow2_prepare, pow2_read },
+	{ "pow2", "produce", 1, pow2_prepare, pow2_produce },
+	{ "pow2", "consume", 0, pow2_prepare, pow2_consume },
+	{ "pow2", "dma_tx",  1, pow2_prepare, pow2_dma_tx },
+	{ "pow2", "dma_rx",  0, pow2_prepare, pow2_dma_rx },
+	{ "spsc", "write",   0, spsc_prepare, spsc_write },
+	{ "spsc", "read",    1, spsc_prepare, spsc_read },
+	{ "spsc", "produce", 1, spsc_prepare, spsc_produce },
+	{ "spsc", "consume", 0, spsc_prepare, spsc_consume },
+};
+
+/* Measurement --------------------------------------------------------------*/
+
+static int compare_samples(const void* a, const void* b)
+{
+	uint64_t x = *(const uint64_t*)a;
+	uint64_t y = *(const uint64_t*)b;
+	return (x > y) - (x < y);
+}
+
+static uint64_t timed_sample(uint64_t start, uint64_t end)
+{
+	uint64_t elapsed = end - start;
+	return elapsed > timestamp_overhead ? elapsed - timestamp_overhead : 0;
+}
+
+static void calibrate(void)
+{
+	struct timespec ts_start, ts_end;
+
+	// Cost of an empty timed region, subtracted from every sample
+	for (int i = 0; i < BENCH_CALLS; i++) {
+		uint64_t start = bench_timestamp();
+		BENCH_BARRIER();
+		samples[i] = bench_timestamp() - start;
+	}
+	qsort(samples, BENCH_CALLS, sizeof(samples[0]), compare_samples);
+	timestamp_overhead = samples[BENCH_CALLS / 2];
+
+	clock_gettime(CLOCK_MONOTONIC, &ts_start);
+	uint64_t start = bench_timestamp();
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &ts_end);
+	} while ((ts_end.tv_sec - ts_start.tv_sec) * 1000000000ll + (ts_end.tv_nsec - ts_start.tv_nsec) < 50000000ll);
+	uint64_t elapsed = bench_timestamp() - start;
+	double us = ((ts_end.tv_sec - ts_start.tv_sec) * 1e9 + (ts_end.tv_nsec - ts_start.tv_nsec)) / 1e3;
+	timestamps_per_us = elapsed / us;
+}
+
+static void summarize(bench_result_t* result, size_t calls)
+{
+	double sum = 0;
+	qsort(samples, calls, sizeof(samples[0]), compare_samples);
+	for (size_t i = 0; i < calls; i++)
+		sum += samples[i];
+
+	result->min = samples[0];
+	result->mean = sum / calls;
+	result->p50 = samples[calls / 2];
+	result->p99 = samples[calls * 99 / 100];
+	result->max = samples[calls - 1];
+	result->mbytes_per_s = result->mean > 0 ? result->chunk * timestamps_per_us / result->mean : 0;
+}
+
+static size_t pattern_offset(bench_pattern_t pattern, size_t ring_size, size_t chunk, size_t call)
+{
+	switch (pattern) {
+	case BENCH_PATTERN_WRAP:
+		return ring_size - (chunk + 1) / 2;
+	case BENCH_PATTERN_STREAM:
+		return (call * chunk) % ring_size;
+	default:
+		return 0;
+	}
+}
+
+static void bench_op(const bench_op_t* op, size_t ring_size, size_t chunk, bench_pattern_t pattern, bench_result_t* result)
+{
+	bench_ctx_t ctx = { .ring_size = ring_size, .chunk = chunk_storage };
+
+	for (size_t i = 0; i < BENCH_CALLS; i++) {
+		op->prepare(&ctx, pattern_offset(pattern, ring_size, chunk, i), op->needs_data ? chunk : 0);
+		BENCH_BARRIER();
+		uint64_t start = bench_timestamp();
+		BENCH_BARRIER();
+		op->run(&ctx, chunk);
+		BENCH_BARRIER();
+		samples[i] = timed_sample(start, bench_timestamp());
+	}
+
+	result->suite = op->suite;
+	result->op = op->op;
+	result->ring_size = ring_size;
+	result->chunk = chunk;
+	result->pattern = bench_pattern_names[pattern];
+	summarize(result, BENCH_CALLS);
+}
+
+static void bench_memcpy(uint8_t* dst, const uint8_t* src, size_t len)
+{
+	memcpy(dst, src, len);
+}
+
+static void bench_copy(void (*copy)(uint8_t*, const uint8_t*, size_t), const char* name,
+	size_t len, size_t src_offset, size_t dst_offset, bench_result_t* result)
+{
+	static char patterns[4][4][8];
+	uint8_t* src = chunk_storage + src_offset;
+	uint8_t* dst = ring_storage + dst_offset;
+
+	for (size_t i = 0; i < BENCH_CALLS; i++) {
+		uint64_t start = bench_timestamp();
+		BENCH_BARRIER();
+		copy(dst, src, len);
+		BENCH_BARRIER();
+		samples[i] = timed_sample(start, bench_timestamp());
+	}
+
+	snprintf(patterns[src_offset][dst_offset], sizeof(patterns[0][0]), "s%zud%zu", src_offset, dst_offset);
+	result->suite = "copy";
+	result->op = name;
+	result->ring_size = 0;
+	result->chunk = len;
+	result->pattern = patterns[src_offset][dst_offset];
+	summarize(result, BENCH_CALLS);
+}
+
+/* Reporting ----------------------------------------------------------------*/
+
+static void bench_key(char key[BENCH_KEY_SIZE], const char* suite, const char* op,
+		size_t ring_size, size_t chunk, const char* pattern)
+{
+	snprintf(key, BENCH_KEY_SIZE, "%s,%s,%zu,%zu,%s", suite, op, ring_size, chunk, pattern);
+}
+
+// FNV-1a
+static size_t bench_key_hash(const char* key)
+{
+	uint32_t hash = 2166136261u;
+	while (*key)
+		hash = (hash ^ (uint8_t)*key++) * 16777619u;
+	return hash;
+}
+
+static bench_baseline_t** bench_index_slot(const bench_options_t* opt, const char* key)
+{
+	size_t i = bench_key_hash(key) & opt->index_mask;
+	while (opt->index[i] != NULL && strcmp(opt->index[i]->key, key) != 0)
+		i = (i + 1) & opt->index_mask;
+	return &opt->index[i];
+}
+
+static const bench_baseline_t* find_baseline(const bench_options_t* opt, const bench_result_t* r)
+{
+	char key[BENCH_KEY_SIZE];
+	if (opt->index == NULL)
+		return NULL;
+	bench_key(key, r->suite, r->op, r->ring_size, r->chunk, r->pattern);
+	return *bench_index_slot(opt, key);
+}
+
+static void report(bench_options_t* opt, const bench_result_t* r)
+{
+	if (opt->json) {
+		printf("{\"suite\":\"%s\",\"op\":\"%s\",\"ring_size\":%zu,\"chunk\":%zu,\"pattern\":\"%s\","
+			"\"calls\":%d,\"unit\":\"%s\",\"min\":%.1f,\"mean\":%.1f,\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f,"
+			"\"mbytes_per_s\":%.1f}\n",
+			r->suite, r->op, r->ring_size, r->chunk, r->pattern, BENCH_CALLS, BENCH_UNIT,
+			r->min, r->mean, r->p50, r->p99, r->max, r->mbytes_per_s);
+	} else {
+		printf("%s,%s,%zu,%zu,%s,%d,%s,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+			r->suite, r->op, r->ring_size, r->chunk, r->pattern, BENCH_CALLS, BENCH_UNIT,
+			r->min, r->mean, r->p50, r->p99, r->max, r->mbytes_per_s);
+	}
+
+	const bench_baseline_t* b = find_baseline(opt, r);
+	// Ignore tiny medians, a couple of cycles of jitter is not a regression
+	if (b && b->p50 > 4 && r->p50 > b->p50 * (1.0 + opt->tolerance / 100.0)) {
+		fprintf(stderr, "regression: %s/%s ring=%zu chunk=%zu %s p50 %.1f -> %.1f\n",
+			r->suite, r->op, r->ring_size, r->chunk, r->pattern, b->p50, r->p50);
+		opt->regressions++;
+	}
+}
+
+/**
+ * @brief Read a CSV run as baseline.
+ *
+ * Every row must parse and be unique, a row that could not be compared
+ * would hide a regression.
+ *
+ * @return 0 on success, -1 after printing the error.
+ */
+static int load_baseline(bench_options_t* opt, const char* path)
+{
+	char line[256], suite[16], op[16], pattern[16];
+	size_t capacity = 0, line_number = 0, ring_size, chunk;
+	double p50;
+	FILE* f = fopen(path, "r");
+	if (!f) {
+		perror(path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		line_number++;
+		if (line[0] == '\n' || strncmp(line, "suite,", 6) == 0)
+			continue;
+		int field_end = 0;
+		if (sscanf(line, "%15[^,],%15[^,],%zu,%zu,%15[^,],%*d,%*[^,],%*f,%*f,%lf,%*f,%*f,%*f%n",
+				suite, op, &ring_size, &chunk, pattern, &p50, &field_end) != 6 || field_end == 0) {
+			fprintf(stderr, "%s:%zu: not a benchmark row\n", path, line_number);
+			fclose(f);
+			return -1;
+		}
+		if (opt->baseline_count == capacity) {
+			capacity = capacity ? capacity * 2 : 256;
+			opt->baseline = realloc(opt->baseline, capacity * sizeof(opt->baseline[0]));
+			if (opt->baseline == NULL) {
+				fprintf(stderr, "out of memory\n");
+				fclose(f);
+				return -1;
+			}
+		}
+		bench_baseline_t* b = &opt->baseline[opt->baseline_count++];
+		bench_key(b->key, suite, op, ring_size, chunk, pattern);
+		b->p50 = p50;
+	}
+	fclose(f);
+
+	// Load factor at most 1/2
+	size_t slots = 2;
+	while (slots < opt->baseline_count * 2)
+		slots *= 2;
+	opt->index = calloc(slots, sizeof(opt->index[0]));
+	if (opt->index == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return -1;
+	}
+	opt->index_mask = slots - 1;
+	for (size_t i = 0; i < opt->baseline_count; i++) {
+		bench_baseline_t** slot = bench_index_slot(opt, opt->baseline[i].key);
+		if (*slot != NULL) {
+			fprintf(stderr, "%s: duplicate row %s\n", path, opt->baseline[i].key);
+			return -1;
+		}
+		*slot = &opt->baseline[i];
+	}
+	return 0;
+}
+
+static int suite_selected(const bench_options_t* opt, const char* suite)
+{
+	return opt->suite == NULL || strcmp(opt->suite, suite) == 0;
+}
+
+int main(int argc, char** argv)
+{
+	static const size_t ring_sizes[] = { 64, 256, 1024, 4096 };
+	static const size_t chunk_sizes[] = { 1, 4, 16, 64, 256, 1024, 4096 };
+	static const size_t copy_sizes[] = { 1, 2, 3, 4, 5, 7, 8, 12, 15, 16, 31, 32, 63, 64,
+		100, 127, 128, 255, 256, 511, 512, 1000, 1023, 1024 };
+	static bench_options_t opt = { .tolerance = 10.0 };
+	bench_result_t result;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--json") == 0) {
+			opt.json = 1;
+		} else if (strcmp(argv[i], "--suite") == 0 && i + 1 < argc) {
+			opt.suite = argv[++i];
+		} else if (strcmp(argv[i], "--tolerance") == 0) {
+			opt.tolerance = parse_double(argc, argv, &i);
+		} else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc && opt.baseline == NULL) {
+			if (load_baseline(&opt, argv[++i]) != 0)
+				return 2;
+		} else {
+			fprintf(stderr, "usage: %s [--json] [--suite ring|pow2|spsc|copy] [--baseline file.csv] [--tolerance pct]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	calibrate();
+	if (!opt.json)
+		printf("suite,op,ring_size,chunk,pattern,calls,unit,min,mean,p50,p99,max,mbytes_per_s\n");
+
+	for (size_t o = 0; o < sizeof(bench_ops)/sizeof(bench_ops[0]); o++) {
+		if (!suite_selected(&opt, bench_ops[o].suite))
+			continue;
+		for (size_t r = 0; r < sizeof(ring_sizes)/sizeof(ring_sizes[0]); r++) {
+			for (size_t c = 0; c < sizeof(chunk_sizes)/sizeof(chunk_sizes[0]); c++) {
+				if (chunk_sizes[c] > ring_sizes[r])
+					continue;
+				for (int p = 0; p < BENCH_PATTERN_COUNT; p++) {
+					bench_op(&bench_ops[o], ring_sizes[r], chunk_sizes[c], p, &result);
+					report(&opt, &result);
+				}
+			}
+		}
+	}
+
+	if (suite_selected(&opt, "copy")) {
+		for (size_t i = 0; i < sizeof(copy_sizes)/sizeof(copy_sizes[0]); i++) {
+			for (size_t src_offset = 0; src_offset < 4; src_offset++) {
+				for (size_t dst_offset = 0; dst_offset < 4; dst_offset++) {
+					bench_copy(bench_memcpy, "memcpy", copy_sizes[i], src_offset, dst_offset, &result);
+					report(&opt, &result);
+					bench_copy(ring_copy, "ring_copy", copy_sizes[i], src_offset, dst_offset, &result);
+					report(&opt, &result);
+				}
+			}
+		}
+	}
+
+	free(opt.index);
+	free(opt.baseline);
+	return opt.regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,285 @@
+/*
+ * rx_error_sim.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Host simulator of the RX DMA path on a noisy line: injects reception
+ * errors (ORE, FE, NE) into a saturated byte stream and reports how much
+ * of the stream reaches the reader.
+ *
+ * The ring is the real ring_buffer_t and normal mode blocks come from the
+ * real get_size_to_consume_per_dma_operation(). The reader drains the
+ * ring periodically. Modes:
+ *  - stall:    no error callback, the first error stops RX DMA for good
+ *              (the driver before HAL_UART_ErrorCallback() was added),
+ *  - hal:      HAL aborts RX DMA on every error, the callback commits what
+ *              DMA wrote, keeps the byte left in DR and restarts after the
+ *              recovery latency. Circular DMA resumes at the write index
+ *              in normal mode and returns to circular at the ring start,
+ *  - ll:       the LL backend only counts errors, DMA keeps running.
+ *
+ * While DMA is stopped DR holds one byte, every further byte is an
+ * overrun. An HAL restart clears ORE by reading DR, so a byte waiting
+ * there at a normal mode restart is lost; the LL backend lets DMA take it.
+ * Errored bytes themselves (FE, NE) are delivered and counted as corrupt,
+ * an ORE loses its byte.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -ICore/Inc Core/Src/ring_buffer.c Core/Src/ring_copy.c Core/Src/dma_ring_buffer.c \
+ *       Tools/ring_bench/rx_error_sim.c -o rx_error_sim && ./rx_error_sim [options]
+ *
+ * Options:
+ *   --error-ppm N       errors per million bytes (default: sweep 0..10000)
+ *   --recover-cycles N  HAL error interrupt, DMA abort and restart (default 2000)
+ *   --hal-cycles N      HAL normal mode restart latency (default 900)
+ *   --ll-cycles N       LL normal mode restart latency (default 300)
+ *   --reader-us N       reader period in us (default 500)
+ *   --bytes N           bytes offered per run (default 1 MiB)
+ */
+
+#include <ring_buffer.h>
+#include <dma_ring_buffer.h>
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SIM_CPU_HZ         72000000.0
+#define SIM_RING_SIZE      1024
+#define SIM_BITS_PER_CHAR  10
+
+typedef enum {
+	SIM_MODE_STALL,
+	SIM_MODE_HAL,
+	SIM_MODE_LL,
+} sim_mode_t;
+
+static const char* const sim_mode_names[] = { "stall", "hal", "ll" };
+
+typedef struct {
+	uint32_t recover_cycles;
+	uint32_t hal_cycles;
+	uint32_t ll_cycles;
+	uint32_t reader_us;
+	uint64_t total_bytes;
+} sim_config_t;
+
+typedef struct {
+	uint64_t errors;
+	uint64_t restarts;      /* DMA restarts after an error */
+	uint64_t lost;          /* bytes that never reached the ring */
+	uint64_t corrupt;       /* delivered bytes received with FE or NE */
+	uint64_t delivered;     /* bytes the reader got */
+	uint64_t circular;      /* bytes received while DMA was circular */
+} sim_result_t;
+
+typedef struct {
+	ring_buffer_t rb;
+	int running;            // DMA channel enabled
+	int circular;           // channel in circular mode
+	int circular_resume;    // circular mode suspended by an error
+	int recovering;         // restart is the error callback's
+	int dr_full;            // DR holds a byte DMA did not take
+	int dr_bad;             // that byte was received with an error
+	double restart_at;      // pending channel start, < 0 if none
+	size_t block_left;      // normal mode: bytes left in the DMA block
+} sim_rx_t;
+
+static uint8_t ring_storage[SIM_RING_SIZE];
+
+static inline uint32_t sim_random(uint32_t* state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static void sim_write(sim_rx_t* rx, uint8_t value, sim_result_t* result)
+{
+	ring_buffer_t* rb = &rx->rb;
+
+	// Circular overrun, the driver discards the ring on resync
+	if (ring_buffer_get_free_size(rb) == 0) {
+		result->lost++;
+		return;
+	}
+	rb->data[rb->tail] = value;
+	ring_buffer_consume(rb, 1);
+	if (rx->circular)
+		result->circular++;
+}
+
+// Same decisions as uart_start_rx_dma_receive()
+static void sim_start(sim_rx_t* rx, sim_mode_t mode, sim_result_t* result)
+{
+	ring_buffer_t* rb = &rx->rb;
+
+	rx->restart_at = -1;
+	if (rx->recovering) {
+		// HAL_UART_ErrorCallback(): keep a good byte left in DR
+		rx->recovering = 0;
+		if (rx->dr_full && !rx->dr_bad && ring_buffer_get_free_size(rb) != 0) {
+			sim_write(rx, 0, result);
+			rx->dr_full = 0;
+		}
+		if (rx->circular && rb->tail != 0 && ring_buffer_get_used_size(rb) != 0) {
+			rx->circular = 0;
+			rx->circular_resume = 1;
+		}
+	}
+
+	if (rx->circular_resume && (rb->tail == 0 || ring_buffer_get_used_size(rb) == 0)) {
+		rx->circular_resume = 0;
+		rx->circular = 1;
+	}
+	if (rx->circular && ring_buffer_get_used_size(rb) == 0) {
+		rb->head = 0;
+		rb->tail = 0;
+	}
+	if (!rx->circular) {
+		rx->block_left = get_size_to_consume_per_dma_operation(rb);
+		if (ring_buffer_get_free_size(rb) == 0)
+			return;
+	}
+	rx->running = 1;
+
+	// HAL clears ORE by reading DR, LL lets DMA take the waiting byte
+	if (rx->dr_full) {
+		rx->dr_full = 0;
+		if (mode == SIM_MODE_LL && !rx->dr_bad)
+			sim_write(rx, 0, result);
+		else
+			result->lost++;
+	}
+}
+
+static sim_result_t sim_run(sim_mode_t mode, double baud, uint32_t error_ppm, const sim_config_t* cfg)
+{
+	sim_result_t result = { 0 };
+	sim_rx_t rx = {
+		.rb = { ring_storage, 0, 0, SIM_RING_SIZE, SIM_RING_SIZE },
+		.running = 1,
+		.circular = 1,
+		.restart_at = -1,
+	};
+	double char_time = SIM_BITS_PER_CHAR / baud;
+	double reader_period = cfg->reader_us * 1e-6;
+	double next_read = reader_period;
+	double restart_latency = (mode == SIM_MODE_LL ? cfg->ll_cycles : cfg->hal_cycles) / SIM_CPU_HZ;
+	uint32_t seed = 0x13579bdf;
+
+	for (uint64_t i = 0; i < cfg->total_bytes; i++) {
+		double now = (i + 1) * char_time;
+
+		// Reader task: commit everything, restart DMA waiting for space
+		while (next_read <= now) {
+			size_t used = ring_buffer_get_used_size(&rx.rb);
+			ring_buffer_commit(&rx.rb, used);
+			result.delivered += used;
+			if (!rx.running && rx.restart_at < 0 && mode != SIM_MODE_STALL && !rx.recovering)
+				rx.restart_at = next_read + restart_latency;
+			next_read += reader_period;
+		}
+
+		if (!rx.running && rx.restart_at >= 0 && rx.restart_at <= now)
+			sim_start(&rx, mode, &result);
+
+		int error = sim_random(&seed) % 1000000 < error_ppm;
+		int overrun = error && sim_random(&seed) % 3 == 0;
+		result.errors += error;
+
+		if (overrun) {
+			result.lost++;
+		} else if (rx.running) {
+			sim_write(&rx, (uint8_t)i, &result);
+			result.corrupt += error;
+			if (!rx.circular && --rx.block_left == 0) {
+				// Normal mode block complete, restarted from the TC interrupt
+				rx.running = 0;
+				rx.restart_at = now + restart_latency;
+			}
+		} else if (!rx.dr_full) {
+			rx.dr_full = 1;
+			rx.dr_bad = error;
+		} else {
+			result.lost++;
+		}
+
+		// HAL aborts reception on any error while DMA receives
+		if (error && rx.running && mode != SIM_MODE_LL) {
+			rx.running = 0;
+			rx.restart_at = -1;
+			if (mode == SIM_MODE_HAL) {
+				rx.recovering = 1;
+				rx.restart_at = now + cfg->recover_cycles / SIM_CPU_HZ;
+				result.restarts++;
+			}
+		}
+	}
+
+	result.delivered += ring_buffer_get_used_size(&rx.rb);
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	static const double bauds[] = { 115200, 921600 };
+	uint32_t error_rates[] = { 0, 100, 1000, 10000 };
+	size_t error_rate_count = sizeof(error_rates)/sizeof(error_rates[0]);
+	sim_config_t cfg = {
+		.recover_cycles = 2000,
+		.hal_cycles = 900,
+		.ll_cycles = 300,
+		.reader_us = 500,
+		.total_bytes = 1 << 20,
+	};
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--error-ppm") == 0) {
+			error_rates[0] = parse_arg(argc, argv, &i);
+			error_rate_count = 1;
+		} else if (strcmp(argv[i], "--recover-cycles") == 0)
+			cfg.recover_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--hal-cycles") == 0)
+			cfg.hal_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--ll-cycles") == 0)
+			cfg.ll_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--reader-us") == 0)
+			cfg.reader_us = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--bytes") == 0)
+			cfg.total_bytes = parse_arg(argc, argv, &i);
+		else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+	if (cfg.reader_us == 0) {
+		fprintf(stderr, "--reader-us must be non-zero\n");
+		return 2;
+	}
+
+	printf("mode,baud,error_ppm,errors,restarts,lost_bytes,lost_per_error,corrupt_bytes,circular_share,delivered\n");
+	for (size_t b = 0; b < sizeof(bauds)/sizeof(bauds[0]); b++) {
+		for (size_t e = 0; e < error_rate_count; e++) {
+			for (int mode = SIM_MODE_STALL; mode <= SIM_MODE_LL; mode++) {
+				sim_result_t r = sim_run(mode, bauds[b], error_rates[e], &cfg);
+				uint64_t received = r.delivered ? r.delivered : 1;
+				printf("%s,%.0f,%u,%llu,%llu,%llu,%.2f,%llu,%.4f,%.4f\n",
+					sim_mode_names[mode], bauds[b], error_rates[e],
+					(unsigned long long)r.errors,
+					(unsigned long long)r.restarts,
+					(unsigned long long)r.lost,
+					r.errors ? (double)r.lost / r.errors : 0.0,
+					(unsigned long long)r.corrupt,
+					(double)r.circular / received,
+					(double)r.delivered / cfg.total_bytes);
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,321 @@
+/*
+ * rx_stream_sim.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Host simulator comparing the two RX delivery paths of the driver on
+ * bursty traffic: reader latency and CPU cost.
+ *  - ring:     every RX DMA event (half/full ring, IDLE) notifies the
+ *              reader task, which copies the data out of the RX ring,
+ *  - stream:   every RX DMA event copies the new data into the port's
+ *              stream buffer (UART_RX_STREAM_BUFFER). The blocked reader
+ *              is woken once the trigger level is reached or its receive
+ *              timeout expires, and copies the data out of the stream.
+ *
+ * Traffic is a sequence of messages of random length separated by random
+ * idle gaps. The RX ring is only updated on DMA events, so a message
+ * becomes visible at its IDLE event (one character after its last byte)
+ * at the earliest. Latency is measured from the last byte of a message
+ * on the wire to the reader having it.
+ *
+ * CPU costs are cycle estimates; replace them with numbers measured on the
+ * target (UART_DMA_PROFILE, DWT around the callbacks).
+ *
+ * Build and run from repository root:
+ *   gcc -O2 Tools/ring_bench/rx_stream_sim.c -o rx_stream_sim && ./rx_stream_sim [options]
+ *
+ * Options:
+ *   --baud N            line rate (default 115200)
+ *   --messages N        messages per run (default 20000)
+ *   --max-message N     largest message in bytes (default 64)
+ *   --max-gap N         largest gap between messages, character times (default 200)
+ *   --timeout-us N      stream reader receive timeout (default 10000)
+ *   --isr-cycles N      RX event interrupt with HAL callback (default 600)
+ *   --wake-cycles N     task notification, switch in and out of the reader (default 1500)
+ *   --send-cycles N     xStreamBufferSendFromISR() fixed cost (default 250)
+ *   --receive-cycles N  xStreamBufferReceive() fixed cost (default 250)
+ *   --copy-cycles N     cycles per copied byte (default 3)
+ */
+
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SIM_CPU_HZ         72000000.0
+#define SIM_RING_SIZE      1024
+#define SIM_STREAM_SIZE    256
+#define SIM_BITS_PER_CHAR  10
+#define SIM_MAX_PENDING    4096
+
+typedef struct {
+	double baud;
+	uint32_t messages;
+	uint32_t max_message;
+	uint32_t max_gap;
+	uint32_t timeout_us;
+	uint32_t isr_cycles;
+	uint32_t wake_cycles;
+	uint32_t send_cycles;
+	uint32_t receive_cycles;
+	uint32_t copy_cycles;
+} sim_config_t;
+
+typedef struct {
+	uint64_t wakeups;
+	uint64_t bytes;
+	uint64_t cycles;
+	uint64_t latency_count;
+	double latency_total;
+	double latency_max;
+	double duration;
+} sim_result_t;
+
+typedef struct {
+	uint64_t end_byte;      // cumulative byte count after the message
+	double end_time;        // last byte received
+} sim_message_t;
+
+// Messages received but not yet delivered, in order
+typedef struct {
+	sim_message_t items[SIM_MAX_PENDING];
+	size_t head;
+	size_t count;
+} sim_pending_t;
+
+static inline uint32_t sim_random(uint32_t* state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static void sim_pending_push(sim_pending_t* p, uint64_t end_byte, double end_time)
+{
+	if (p->count == SIM_MAX_PENDING) {
+		fprintf(stderr, "too many undelivered messages\n");
+		exit(1);
+	}
+	p->items[(p->head + p->count++) % SIM_MAX_PENDING] = (sim_message_t){ end_byte, end_time };
+}
+
+// Reader has every byte up to @p delivered at @p now
+static void sim_deliver(sim_pending_t* p, uint64_t delivered, double now, sim_result_t* result)
+{
+	while (p->count != 0 && p->items[p->head].end_byte <= delivered) {
+		double latency = now - p->items[p->head].end_time;
+		result->latency_total += latency;
+		result->latency_count++;
+		if (latency > result->latency_max)
+			result->latency_max = latency;
+		p->head = (p->head + 1) % SIM_MAX_PENDING;
+		p->count--;
+	}
+}
+
+typedef struct {
+	int stream;             // stream delivery, otherwise ring
+	uint32_t trigger;
+	uint64_t received;      // bytes committed to the RX ring by DMA events
+	uint64_t in_stream;     // bytes moved into the stream buffer
+	uint64_t delivered;     // bytes the reader has
+	int blocked;            // stream reader waits in xStreamBufferReceive()
+	double block_start;
+	double busy_until;      // reader still running until then
+} sim_reader_t;
+
+// Reader wakes at @p now and takes everything visible to it
+static void sim_reader_run(sim_reader_t* r, const sim_config_t* cfg, sim_pending_t* p,
+		double now, sim_result_t* result)
+{
+	if (now < r->busy_until)
+		now = r->busy_until;
+
+	result->wakeups++;
+	result->cycles += cfg->wake_cycles;
+	if (r->stream) {
+		// Receive, move what the ring held back, receive again until empty
+		for (;;) {
+			uint64_t size = r->in_stream - r->delivered;
+			if (size == 0)
+				break;
+			result->cycles += cfg->receive_cycles + size * cfg->copy_cycles;
+			r->delivered = r->in_stream;
+			uint64_t spill = r->received - r->in_stream;
+			if (spill > SIM_STREAM_SIZE)
+				spill = SIM_STREAM_SIZE;
+			if (spill != 0)
+				result->cycles += cfg->send_cycles + spill * cfg->copy_cycles;
+			r->in_stream += spill;
+		}
+		r->blocked = 1;
+		r->block_start = now;
+	} else {
+		uint64_t size = r->received - r->delivered;
+		result->cycles += size * cfg->copy_cycles;
+		r->delivered = r->received;
+	}
+
+	r->busy_until = now + cfg->wake_cycles / SIM_CPU_HZ;
+	sim_deliver(p, r->delivered, now, result);
+}
+
+// RX DMA event at @p now, @p received bytes are in the ring
+static void sim_rx_event(sim_reader_t* r, const sim_config_t* cfg, sim_pending_t* p,
+		double now, uint64_t received, sim_result_t* result)
+{
+	double wake_latency = cfg->wake_cycles / SIM_CPU_HZ;
+	uint64_t new_size = received - r->received;
+
+	result->cycles += cfg->isr_cycles;
+	r->received = received;
+	if (new_size == 0)
+		return;
+
+	if (!r->stream) {
+		sim_reader_run(r, cfg, p, now + wake_latency, result);
+		return;
+	}
+
+	// Copy into the stream what fits, the rest waits in the ring
+	uint64_t room = SIM_STREAM_SIZE - (r->in_stream - r->delivered);
+	uint64_t send_size = r->received - r->in_stream;
+	if (send_size > room)
+		send_size = room;
+	if (send_size != 0)
+		result->cycles += cfg->send_cycles + send_size * cfg->copy_cycles;
+	r->in_stream += send_size;
+
+	if (r->blocked && r->in_stream - r->delivered >= r->trigger) {
+		r->blocked = 0;
+		sim_reader_run(r, cfg, p, now + wake_latency, result);
+	}
+}
+
+// Stream reader timeouts expiring before @p now
+static void sim_timeouts(sim_reader_t* r, const sim_config_t* cfg, sim_pending_t* p,
+		double now, sim_result_t* result)
+{
+	double timeout = cfg->timeout_us * 1e-6;
+
+	while (r->stream && r->blocked && r->block_start + timeout <= now) {
+		r->blocked = 0;
+		sim_reader_run(r, cfg, p, r->block_start + timeout, result);
+	}
+}
+
+static sim_result_t sim_run(int stream, uint32_t trigger, const sim_config_t* cfg)
+{
+	sim_result_t result = { 0 };
+	sim_pending_t pending = { .head = 0, .count = 0 };
+	sim_reader_t reader = { .stream = stream, .trigger = trigger, .blocked = 1 };
+	double char_time = SIM_BITS_PER_CHAR / cfg->baud;
+	double now = 0;
+	uint64_t received = 0;
+	uint32_t seed = 0x0badf00d;
+
+	for (uint32_t m = 0; m < cfg->messages; m++) {
+		uint32_t size = 1 + sim_random(&seed) % cfg->max_message;
+		uint32_t gap = sim_random(&seed) % (cfg->max_gap + 1);
+
+		// Known up front, a ring event on the last byte already delivers it
+		sim_pending_push(&pending, received + size, now + size * char_time);
+		for (uint32_t i = 0; i < size; i++) {
+			now += char_time;
+			received++;
+			sim_timeouts(&reader, cfg, &pending, now, &result);
+			// Circular DMA half and full ring events
+			if (received % (SIM_RING_SIZE / 2) == 0)
+				sim_rx_event(&reader, cfg, &pending, now, received, &result);
+		}
+
+		// IDLE is raised after one idle character
+		if (gap != 0) {
+			sim_timeouts(&reader, cfg, &pending, now + char_time, &result);
+			sim_rx_event(&reader, cfg, &pending, now + char_time, received, &result);
+		}
+		now += gap * char_time;
+	}
+
+	// Drain: one more timeout delivers what sits below the trigger level
+	sim_timeouts(&reader, cfg, &pending, now + cfg->timeout_us * 1e-6 + 1, &result);
+	sim_rx_event(&reader, cfg, &pending, now + char_time, received, &result);
+	sim_timeouts(&reader, cfg, &pending, now + 2 * cfg->timeout_us * 1e-6 + 1, &result);
+
+	result.bytes = received;
+	result.duration = now;
+	return result;
+}
+
+static void sim_print(const char* mode, uint32_t trigger, const sim_config_t* cfg, const sim_result_t* r)
+{
+	printf("%s,%u,%.0f,%llu,%llu,%.1f,%.1f,%.2f,%.4f\n", mode, trigger, cfg->baud,
+		(unsigned long long)r->latency_count,
+		(unsigned long long)r->wakeups,
+		r->latency_count ? r->latency_total / r->latency_count * 1e6 : 0.0,
+		r->latency_max * 1e6,
+		(double)r->cycles / r->bytes,
+		r->cycles / (r->duration * SIM_CPU_HZ));
+}
+
+int main(int argc, char** argv)
+{
+	static const uint32_t triggers[] = { 1, 16, 64, 256 };
+	sim_config_t cfg = {
+		.baud = 115200,
+		.messages = 20000,
+		.max_message = 64,
+		.max_gap = 200,
+		.timeout_us = 10000,
+		.isr_cycles = 600,
+		.wake_cycles = 1500,
+		.send_cycles = 250,
+		.receive_cycles = 250,
+		.copy_cycles = 3,
+	};
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--baud") == 0)
+			cfg.baud = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--messages") == 0)
+			cfg.messages = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--max-message") == 0)
+			cfg.max_message = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--max-gap") == 0)
+			cfg.max_gap = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--timeout-us") == 0)
+			cfg.timeout_us = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--isr-cycles") == 0)
+			cfg.isr_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--wake-cycles") == 0)
+			cfg.wake_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--send-cycles") == 0)
+			cfg.send_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--receive-cycles") == 0)
+			cfg.receive_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--copy-cycles") == 0)
+			cfg.copy_cycles = parse_arg(argc, argv, &i);
+		else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+	if (cfg.baud <= 0 || cfg.messages == 0 || cfg.max_message == 0 || cfg.max_message > SIM_RING_SIZE) {
+		fprintf(stderr, "--baud, --messages must be non-zero, --max-message 1..%d\n", SIM_RING_SIZE);
+		return 2;
+	}
+
+	printf("mode,trigger,baud,messages,wakeups,avg_latency_us,max_latency_us,cycles_per_byte,cpu_load\n");
+	sim_result_t r = sim_run(0, 0, &cfg);
+	sim_print("ring", 0, &cfg, &r);
+	for (size_t t = 0; t < sizeof(triggers)/sizeof(triggers[0]); t++) {
+		r = sim_run(1, triggers[t], &cfg);
+		sim_print("stream", triggers[t], &cfg, &r);
+	}
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * tool_args.h
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Option value parsing shared by the host tools in Tools/ring_bench.
+ * A missing or malformed value prints an error and exits with code 2,
+ * the usage error code of every tool.
+ */
+
+#ifndef __TOOL_ARGS_H__
+#define __TOOL_ARGS_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/**
+ * @brief Take the value following option argv[*i].
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @param i Index of the option, advanced to its value.
+ * @return The value string.
+ */
+static inline const char* tool_arg_value(int argc, char** argv, int* i)
+{
+	if (*i + 1 >= argc) {
+		fprintf(stderr, "missing value for %s\n", argv[*i]);
+		exit(2);
+	}
+	return argv[++*i];
+}
+
+/**
+ * @brief Parse the unsigned integer value of option argv[*i].
+ *
+ * Decimal, 0x hexadecimal and 0 octal are accepted.
+ *
+ * @return The value.
+ */
+static inline uint64_t parse_arg(int argc, char** argv, int* i)
+{
+	const char* option = argv[*i];
+	const char* value = tool_arg_value(argc, argv, i);
+	char* end;
+	uint64_t result = strtoull(value, &end, 0);
+
+	if (*value == '\0' || *value == '-' || *end != '\0') {
+		fprintf(stderr, "invalid value %s for %s\n", value, option);
+		exit(2);
+	}
+	return result;
+}
+
+/**
+ * @brief Parse the floating point value of option argv[*i].
+ * @return The value.
+ */
+static inline double parse_double(int argc, char** argv, int* i)
+{
+	const char* option = argv[*i];
+	const char* value = tool_arg_value(argc, argv, i);
+	char* end;
+	double result = strtod(value, &end);
+
+	if (*value == '\0' || *end != '\0') {
+		fprintf(stderr, "invalid value %s for %s\n", value, option);
+		exit(2);
+	}
+	return result;
+}
+
+#endif
@@ -0,0 +1,196 @@
+/*
+ * tx_sim.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Host simulator of the TX DMA path: measures how long the UART line sits
+ * idle between DMA transfers while data is waiting in the TX ring.
+ *
+ * The ring is the real mp_ring_buffer_t, kept full by a saturating
+ * producer writing random sized chunks, so transfer sizes and ring wrap
+ * splits are exactly what the driver would see. Line timing is modelled
+ * per character:
+ *  - hal:      completion is reported at USART TC (line already idle),
+ *              the next transfer starts after the restart latency,
+ *  - ll:       completion at DMA TC, DR and the shift register still
+ *              hold two characters that hide part of the latency,
+ *  - pingpong: like ll, but the next block is armed in advance and the
+ *              interrupt only re-arms the channel.
+ *
+ * Restart latencies are CPU cycles from the completion event to the next
+ * channel enable. The defaults are estimates; replace them with target
+ * numbers from UART_DMA_PROFILE (tx_restart) plus interrupt entry.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -ICore/Inc Core/Src/ring_copy.c Core/Src/mp_ring_buffer.c \
+ *       Tools/ring_bench/tx_sim.c -o tx_sim && ./tx_sim [options]
+ *
+ * Options:
+ *   --hal-cycles N      restart latency of the HAL backend (default 900)
+ *   --ll-cycles N       restart latency of the LL backend (default 300)
+ *   --chain-cycles N    re-arm latency of a prepared block (default 80)
+ *   --max-chunk N       largest producer write in bytes (default 200)
+ *   --bytes N           bytes transmitted per run (default 1 MiB)
+ */
+
+#include <mp_ring_buffer.h>
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SIM_CPU_HZ         72000000.0
+#define SIM_RING_SIZE      1024
+#define SIM_BITS_PER_CHAR  10
+
+typedef enum {
+	SIM_MODE_HAL,
+	SIM_MODE_LL,
+	SIM_MODE_PINGPONG,
+} sim_mode_t;
+
+static const char* const sim_mode_names[] = { "hal", "ll", "pingpong" };
+
+typedef struct {
+	uint32_t hal_cycles;
+	uint32_t ll_cycles;
+	uint32_t chain_cycles;
+	uint32_t max_chunk;
+	uint64_t total_bytes;
+} sim_config_t;
+
+typedef struct {
+	uint64_t transfers;
+	uint64_t bytes;
+	uint64_t gaps;          /* transfers preceded by an idle line */
+	double idle_seconds;
+	double line_seconds;
+} sim_result_t;
+
+static uint8_t ring_storage[SIM_RING_SIZE];
+static mp_ring_buffer_t ring;
+
+static inline uint32_t sim_random(uint32_t* state)
+{
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+// Saturating producer: refill until the next chunk does not fit
+static void sim_fill(uint32_t* seed, uint32_t max_chunk)
+{
+	static uint8_t chunk[4096];
+
+	for (;;) {
+		uint32_t start;
+		size_t len = 1 + sim_random(seed) % max_chunk;
+		if (mp_ring_buffer_reserve(&ring, len, &start) != 0)
+			return;
+		mp_ring_buffer_copy_in(&ring, start, chunk, len);
+		mp_ring_buffer_commit(&ring);
+	}
+}
+
+static sim_result_t sim_run(sim_mode_t mode, double baud, const sim_config_t* cfg)
+{
+	sim_result_t result = { 0 };
+	double char_time = SIM_BITS_PER_CHAR / baud;
+	double line_end = 0;        // when the last queued character leaves the wire
+	double start = 0;           // when the current transfer's channel is enabled
+	uint32_t seed = 0x2468ace1;
+	size_t next_size = 0;
+
+	mp_ring_buffer_init(&ring, ring_storage, SIM_RING_SIZE);
+	sim_fill(&seed, cfg->max_chunk);
+
+	while (result.bytes < cfg->total_bytes) {
+		uint8_t* data;
+		size_t size = mp_ring_buffer_peek_linear(&ring, &data);
+
+		// Line was drained before the channel came back
+		if (start > line_end) {
+			result.idle_seconds += start - line_end;
+			result.gaps += result.transfers != 0;
+			line_end = start;
+		}
+
+		if (mode == SIM_MODE_PINGPONG)
+			next_size = mp_ring_buffer_peek_linear_at(&ring, size, &data);
+
+		// Last byte enters DR when the one before it starts shifting
+		double first_shift = line_end;
+		line_end += size * char_time;
+		double dma_tc = size > 1 ? line_end - 2 * char_time : first_shift;
+		if (dma_tc < start)
+			dma_tc = start;
+
+		double completion = mode == SIM_MODE_HAL ? line_end : dma_tc;
+		uint32_t latency = mode == SIM_MODE_HAL ? cfg->hal_cycles :
+			(mode == SIM_MODE_PINGPONG && next_size != 0) ? cfg->chain_cycles : cfg->ll_cycles;
+		start = completion + latency / SIM_CPU_HZ;
+
+		mp_ring_buffer_release(&ring, size);
+		sim_fill(&seed, cfg->max_chunk);
+
+		result.transfers++;
+		result.bytes += size;
+	}
+
+	result.line_seconds = line_end;
+	return result;
+}
+
+int main(int argc, char** argv)
+{
+	static const double bauds[] = { 115200, 921600, 2000000, 4500000 };
+	sim_config_t cfg = {
+		.hal_cycles = 900,
+		.ll_cycles = 300,
+		.chain_cycles = 80,
+		.max_chunk = 200,
+		.total_bytes = 1 << 20,
+	};
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--hal-cycles") == 0)
+			cfg.hal_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--ll-cycles") == 0)
+			cfg.ll_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--chain-cycles") == 0)
+			cfg.chain_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--max-chunk") == 0)
+			cfg.max_chunk = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--bytes") == 0)
+			cfg.total_bytes = parse_arg(argc, argv, &i);
+		else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+	if (cfg.max_chunk == 0 || cfg.max_chunk > SIM_RING_SIZE / 2) {
+		fprintf(stderr, "--max-chunk must be 1..%d\n", SIM_RING_SIZE / 2);
+		return 2;
+	}
+
+	printf("mode,baud,transfers,avg_transfer,gaps,idle_us_total,idle_us_per_transfer,utilization\n");
+	for (size_t b = 0; b < sizeof(bauds)/sizeof(bauds[0]); b++) {
+		for (int mode = SIM_MODE_HAL; mode <= SIM_MODE_PINGPONG; mode++) {
+			sim_result_t r = sim_run(mode, bauds[b], &cfg);
+			printf("%s,%.0f,%llu,%.1f,%llu,%.1f,%.3f,%.4f\n",
+				sim_mode_names[mode], bauds[b],
+				(unsigned long long)r.transfers,
+				(double)r.bytes / r.transfers,
+				(unsigned long long)r.gaps,
+				r.idle_seconds * 1e6,
+				r.idle_seconds * 1e6 / r.transfers,
+				1.0 - r.idle_seconds / r.line_seconds);
+		}
+	}
+	return 0;
+}
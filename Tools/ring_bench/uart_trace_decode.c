@@ -0,0 +1,312 @@
+/*
+ * uart_trace_decode.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Decoder for UART_TRACE dumps (the uart_trace object, format in
+ * Core/Inc/uart_trace.h). Reads a dump file or stdin, finds the dump by its
+ * magic, so a raw serial capture or a debugger memory dump with data
+ * around it works, puts the records back in order and converts cycle
+ * counts to microseconds from the first record.
+ *
+ * Default output is one CSV row per port: TX DMA transfers and bytes, the
+ * gaps between a transfer complete and the next start, time spent in
+ * transfers, line utilization (character time of the bytes moved over the
+ * trace span), RX events by type, RX restarts and the time RX DMA was
+ * stopped.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 -ICore/Inc Tools/ring_bench/uart_trace_decode.c -o uart_trace_decode
+ *   ./uart_trace_decode [--timeline | --transfers] [--bits N] [dump.bin]
+ *
+ * Options:
+ *   --timeline  print every record: time, delta to the previous record,
+ *               port, event and argument
+ *   --transfers print every TX DMA transfer: start, length, duration,
+ *               gap since the previous transfer completed and efficiency
+ *               (line time of its bytes over its duration)
+ *   --bits N    bits per character on the line, default 10 (8N1)
+ *
+ * Timestamps are 32-bit cycle counts, records more than 2^31 cycles apart
+ * (about 30 s at 72 MHz) can not be ordered.
+ */
+
+#include <uart_trace.h>
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+	double time_us;
+	uint8_t event;
+	uint8_t port;
+	uint16_t arg;
+} decode_record_t;
+
+typedef struct {
+	char name[UART_TRACE_PORT_NAME_SIZE + 1];
+	uint32_t baud;
+
+	// TX transfers
+	uint32_t tx_transfers;
+	uint64_t tx_bytes;
+	double tx_start_us;         // < 0: no transfer running
+	uint32_t tx_length;
+	double tx_tc_us;            // < 0: no transfer completed yet
+	double tx_busy_us;
+	uint32_t tx_gaps;
+	double tx_gap_sum_us, tx_gap_min_us, tx_gap_max_us;
+
+	// RX
+	uint32_t rx_events[3];      // HT, TC, IDLE
+	uint64_t rx_bytes;
+	uint32_t rx_starts;
+	uint32_t rx_stops;
+	double rx_stopped_at_us;    // < 0: running or unknown
+	double rx_stopped_us;
+	uint32_t rx_errors;
+} decode_port_t;
+
+static const char* const event_names[] = {
+	[UART_TRACE_TX_START] = "tx_start",
+	[UART_TRACE_TX_TC] = "tx_tc",
+	[UART_TRACE_TX_BUSY] = "tx_busy",
+	[UART_TRACE_TX_HEAD] = "tx_head",
+	[UART_TRACE_TX_TAIL] = "tx_tail",
+	[UART_TRACE_RX_START] = "rx_start",
+	[UART_TRACE_RX_HT] = "rx_ht",
+	[UART_TRACE_RX_TC] = "rx_tc",
+	[UART_TRACE_RX_IDLE] = "rx_idle",
+	[UART_TRACE_RX_BUSY] = "rx_busy",
+	[UART_TRACE_RX_HEAD] = "rx_head",
+	[UART_TRACE_RX_TAIL] = "rx_tail",
+	[UART_TRACE_RX_ERROR] = "rx_error",
+};
+#define EVENT_COUNT (sizeof(event_names) / sizeof(event_names[0]))
+
+static uint32_t get_u32(const uint8_t* p)
+{
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/**
+ * @brief Parse a dump into ports and records in time order.
+ * @return Number of records, -1 if @p data does not start with a valid dump.
+ */
+static long decode_dump(const uint8_t* data, size_t size, uint32_t* cpu_hz,
+		decode_port_t** ports, size_t* port_count, decode_record_t** records)
+{
+	if (size < UART_TRACE_HEADER_SIZE || get_u32(data) != UART_TRACE_MAGIC || data[4] != UART_TRACE_VERSION)
+		return -1;
+
+	size_t count = data[5];
+	uint32_t length = get_u32(data + 12), written = get_u32(data + 16);
+	const uint8_t* raw = data + UART_TRACE_HEADER_SIZE + count * UART_TRACE_PORT_SIZE;
+	if (length == 0 || (length & (length - 1)) != 0 || raw + (size_t)length * 8 > data + size)
+		return -1;
+
+	*cpu_hz = get_u32(data + 8);
+	*port_count = count;
+	*ports = calloc(count ? count : 1, sizeof(decode_port_t));
+	for (size_t i = 0; i < count; i++) {
+		const uint8_t* p = data + UART_TRACE_HEADER_SIZE + i * UART_TRACE_PORT_SIZE;
+		memcpy((*ports)[i].name, p, UART_TRACE_PORT_NAME_SIZE);
+		(*ports)[i].baud = get_u32(p + UART_TRACE_PORT_NAME_SIZE);
+	}
+
+	// Once wrapped, the oldest record is the one written next
+	size_t first = written > length ? written & (length - 1) : 0;
+	size_t n = written > length ? length : written;
+	*records = calloc(n ? n : 1, sizeof(decode_record_t));
+
+	size_t out = 0;
+	uint32_t previous = 0;
+	double cycles = 0;
+	for (size_t i = 0; i < n; i++) {
+		const uint8_t* p = raw + ((first + i) & (length - 1)) * 8;
+		uint32_t time = get_u32(p), info = get_u32(p + 4);
+		decode_record_t* r = &(*records)[out];
+		r->event = (uint8_t)info;
+		r->port = (uint8_t)(info >> 8);
+		r->arg = (uint16_t)(info >> 16);
+		// Skip a record still being written when the trace was stopped
+		if (r->event == 0 || r->event >= EVENT_COUNT || r->port >= count)
+			continue;
+		// A record can be preempted between taking its slot and storing
+		// its time, so small steps back in time are kept signed
+		if (out > 0)
+			cycles += (int32_t)(time - previous);
+		previous = time;
+		r->time_us = *cpu_hz ? cycles * 1e6 / *cpu_hz : cycles;
+		out++;
+	}
+	return (long)out;
+}
+
+/**
+ * @brief Line time of @p bytes at the port's rate.
+ */
+static double line_us(const decode_port_t* p, uint64_t bytes, unsigned bits)
+{
+	return p->baud ? (double)bytes * bits * 1e6 / p->baud : 0.0;
+}
+
+static void account(decode_port_t* p, const decode_record_t* r, unsigned bits, int transfers)
+{
+	switch (r->event) {
+	case UART_TRACE_TX_START:
+		p->tx_start_us = r->time_us;
+		p->tx_length = r->arg;
+		if (p->tx_tc_us >= 0) {
+			double gap = r->time_us - p->tx_tc_us;
+			if (p->tx_gaps == 0 || gap < p->tx_gap_min_us)
+				p->tx_gap_min_us = gap;
+			if (p->tx_gaps == 0 || gap > p->tx_gap_max_us)
+				p->tx_gap_max_us = gap;
+			p->tx_gap_sum_us += gap;
+			p->tx_gaps++;
+		}
+		break;
+	case UART_TRACE_TX_TC:
+		// The start of the first transfer may have been overwritten
+		if (p->tx_start_us >= 0) {
+			double duration = r->time_us - p->tx_start_us;
+			p->tx_transfers++;
+			p->tx_bytes += r->arg;
+			p->tx_busy_us += duration;
+			if (transfers) {
+				printf("%s,%u,%.2f,%u,%.2f,", p->name, p->tx_transfers, p->tx_start_us, r->arg, duration);
+				if (p->tx_tc_us >= 0)
+					printf("%.2f,", p->tx_start_us - p->tx_tc_us);
+				else
+					printf(",");
+				printf("%.4f\n", duration > 0 ? line_us(p, r->arg, bits) / duration : 0.0);
+			}
+		}
+		p->tx_start_us = -1;
+		p->tx_tc_us = r->time_us;
+		break;
+	case UART_TRACE_RX_START:
+		p->rx_starts++;
+		break;
+	case UART_TRACE_RX_HT:
+	case UART_TRACE_RX_TC:
+	case UART_TRACE_RX_IDLE:
+		p->rx_events[r->event - UART_TRACE_RX_HT]++;
+		p->rx_bytes += r->arg;
+		break;
+	case UART_TRACE_RX_BUSY:
+		if (r->arg == 0) {
+			p->rx_stops++;
+			p->rx_stopped_at_us = r->time_us;
+		} else if (p->rx_stopped_at_us >= 0) {
+			p->rx_stopped_us += r->time_us - p->rx_stopped_at_us;
+			p->rx_stopped_at_us = -1;
+		}
+		break;
+	case UART_TRACE_RX_ERROR:
+		p->rx_errors++;
+		break;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* path = NULL;
+	int timeline = 0, transfers = 0;
+	unsigned bits = 10;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--timeline") == 0)
+			timeline = 1;
+		else if (strcmp(argv[i], "--transfers") == 0)
+			transfers = 1;
+		else if (strcmp(argv[i], "--bits") == 0)
+			bits = (unsigned)parse_arg(argc, argv, &i);
+		else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		} else
+			path = argv[i];
+	}
+
+	FILE* f = (path == NULL || strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+	if (f == NULL) {
+		perror(path);
+		return 2;
+	}
+	size_t size = 0, capacity = 1 << 16;
+	uint8_t* data = malloc(capacity);
+	size_t n;
+	while (data != NULL && (n = fread(data + size, 1, capacity - size, f)) > 0) {
+		size += n;
+		if (size == capacity)
+			data = realloc(data, capacity *= 2);
+	}
+	if (f != stdin)
+		fclose(f);
+	if (data == NULL) {
+		fprintf(stderr, "out of memory\n");
+		return 2;
+	}
+
+	uint32_t cpu_hz = 0;
+	decode_port_t* ports = NULL;
+	decode_record_t* records = NULL;
+	size_t port_count = 0;
+	long count = -1;
+	for (size_t offset = 0; offset < size && count < 0; offset++)
+		count = decode_dump(data + offset, size - offset, &cpu_hz, &ports, &port_count, &records);
+	free(data);
+	if (count < 0) {
+		fprintf(stderr, "no trace found\n");
+		return 1;
+	}
+
+	for (size_t i = 0; i < port_count; i++) {
+		ports[i].tx_start_us = -1;
+		ports[i].tx_tc_us = -1;
+		ports[i].rx_stopped_at_us = -1;
+	}
+
+	if (timeline)
+		printf("time_us,delta_us,port,event,arg\n");
+	else if (transfers)
+		printf("port,transfer,start_us,length,duration_us,gap_us,efficiency\n");
+
+	for (long i = 0; i < count; i++) {
+		const decode_record_t* r = &records[i];
+		if (timeline)
+			printf("%.2f,%.2f,%s,%s,%u\n", r->time_us, i > 0 ? r->time_us - records[i - 1].time_us : 0.0,
+				ports[r->port].name, event_names[r->event], r->arg);
+		account(&ports[r->port], r, bits, transfers && !timeline);
+	}
+
+	if (!timeline && !transfers) {
+		double span = count > 0 ? records[count - 1].time_us - records[0].time_us : 0.0;
+		printf("port,baud,span_us,tx_transfers,tx_bytes,tx_gap_min_us,tx_gap_avg_us,tx_gap_max_us,"
+			"tx_busy_share,tx_utilization,rx_ht,rx_tc,rx_idle,rx_bytes,rx_restarts,rx_stops,"
+			"rx_stopped_us,rx_utilization,rx_errors\n");
+		for (size_t i = 0; i < port_count; i++) {
+			decode_port_t* p = &ports[i];
+			// Still stopped at the end of the trace
+			if (p->rx_stopped_at_us >= 0 && count > 0)
+				p->rx_stopped_us += records[count - 1].time_us - p->rx_stopped_at_us;
+			printf("%s,%u,%.2f,%u,%llu,%.2f,%.2f,%.2f,%.4f,%.4f,%u,%u,%u,%llu,%u,%u,%.2f,%.4f,%u\n",
+				p->name, p->baud, span, p->tx_transfers, (unsigned long long)p->tx_bytes,
+				p->tx_gap_min_us, p->tx_gaps ? p->tx_gap_sum_us / p->tx_gaps : 0.0, p->tx_gap_max_us,
+				span > 0 ? p->tx_busy_us / span : 0.0,
+				span > 0 ? line_us(p, p->tx_bytes, bits) / span : 0.0,
+				p->rx_events[0], p->rx_events[1], p->rx_events[2], (unsigned long long)p->rx_bytes,
+				p->rx_starts, p->rx_stops, p->rx_stopped_us,
+				span > 0 ? line_us(p, p->rx_bytes, bits) / span : 0.0, p->rx_errors);
+		}
+	}
+
+	free(ports);
+	free(records);
+	return 0;
+}
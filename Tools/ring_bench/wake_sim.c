@@ -0,0 +1,220 @@
+/*
+ * wake_sim.c
+ *
+ *  Created on: 17 October 2026.
+ *      Author: ASMcoder
+ *
+ * Host model of the echo path on an otherwise idle node: latency from the
+ * last byte of a message on the wire to its echo leaving TX, characters
+ * lost to wakeup and average supply current. Modes:
+ *  - busy:     configUSE_TICKLESS_IDLE 0, the idle task spins and the
+ *              1 kHz tick runs; an IDLE interrupt raised while the tick
+ *              interrupt runs waits for it (same priority),
+ *  - sleep:    tickless idle in Sleep mode (WFI, tick and HAL timebase
+ *              suppressed). RX DMA keeps filling the ring, the IDLE
+ *              interrupt wakes the core; the sleep exit and
+ *              PostSleepProcessing() run before the interrupt handler,
+ *  - stop:     Stop mode woken by EXTI on the RX pin, for comparison. The
+ *              USART has no clock until HSE and PLL are restarted, every
+ *              character that starts before is lost.
+ *
+ * The RX ring is only updated on DMA events, so the reader sees a message
+ * at its IDLE event, one character after its last byte. Messages are short
+ * enough to raise no half/full transfer event.
+ *
+ * CPU costs are cycle estimates and currents are typical datasheet values
+ * (STM32F103 at 72 MHz, peripherals enabled); replace them with numbers
+ * measured on the target.
+ *
+ * Build and run from repository root:
+ *   gcc -O2 Tools/ring_bench/wake_sim.c -o wake_sim && ./wake_sim [options]
+ *
+ * Options:
+ *   --message N             message length in bytes (default 16)
+ *   --rate N                messages per second (default 10)
+ *   --isr-cycles N          IDLE interrupt with HAL callback and notify (default 600)
+ *   --task-cycles N         switch to the echo task, peek and queue (default 1500)
+ *   --tx-cycles N           TX DMA start (default 900)
+ *   --tick-cycles N         tick interrupt, busy mode (default 300)
+ *   --wake-cycles N         WFI exit to first instruction (default 20)
+ *   --post-sleep-cycles N   PostSleepProcessing() and port code before the ISR (default 60)
+ *   --tickless-cycles N     tickless entry and exit bookkeeping per sleep (default 800)
+ *   --stop-wake-us N        Stop mode exit with HSE and PLL restart (default 2000)
+ *   --run-ma F              run current in mA (default 36.0)
+ *   --sleep-ma F            Sleep mode current in mA (default 14.4)
+ *   --stop-ma F             Stop mode current in mA (default 0.024)
+ */
+
+#include "tool_args.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SIM_CPU_HZ         72000000.0
+#define SIM_TICK_HZ        1000.0
+#define SIM_BITS_PER_CHAR  10
+/* Longest tickless sleep: 24-bit SysTick at the CPU clock */
+#define SIM_MAX_SLEEP      (16777215.0 / SIM_CPU_HZ)
+
+typedef enum {
+	SIM_MODE_BUSY,
+	SIM_MODE_SLEEP,
+	SIM_MODE_STOP,
+} sim_mode_t;
+
+static const char* const sim_mode_names[] = { "busy", "sleep", "stop" };
+
+typedef struct {
+	uint32_t message;
+	double rate;
+	uint32_t isr_cycles;
+	uint32_t task_cycles;
+	uint32_t tx_cycles;
+	uint32_t tick_cycles;
+	uint32_t wake_cycles;
+	uint32_t post_sleep_cycles;
+	uint32_t tickless_cycles;
+	uint32_t stop_wake_us;
+	double run_ma;
+	double sleep_ma;
+	double stop_ma;
+} sim_config_t;
+
+typedef struct {
+	uint32_t lost;          /* characters of a message lost to wakeup */
+	double avg_latency;     /* last byte on the wire to echo start, s */
+	double max_latency;
+	double wake_overhead;   /* latency added to the awake path, s */
+	double active_share;    /* share of time the core runs */
+	double current_ma;      /* average supply current */
+} sim_result_t;
+
+static sim_result_t sim_run(sim_mode_t mode, double baud, const sim_config_t* cfg)
+{
+	sim_result_t r = { 0 };
+	double char_time = SIM_BITS_PER_CHAR / baud;
+	double echo_path = (cfg->isr_cycles + cfg->task_cycles + cfg->tx_cycles) / SIM_CPU_HZ;
+	double tick_time = cfg->tick_cycles / SIM_CPU_HZ;
+	double idle_ma = cfg->run_ma;
+
+	switch (mode) {
+	case SIM_MODE_BUSY:
+		// IDLE interrupt lands inside the tick interrupt with probability
+		// tick_time * tick rate and then waits for the rest of it
+		r.wake_overhead = tick_time * SIM_TICK_HZ * tick_time / 2;
+		r.avg_latency = char_time + echo_path + r.wake_overhead;
+		r.max_latency = char_time + echo_path + tick_time;
+		r.active_share = 1.0;
+		break;
+
+	case SIM_MODE_SLEEP: {
+		// Sleeps end on each message and at least every SysTick period
+		double sleeps = cfg->rate + 1.0 / SIM_MAX_SLEEP;
+		double active = cfg->rate * echo_path
+			+ sleeps * (cfg->wake_cycles + cfg->post_sleep_cycles + cfg->tickless_cycles) / SIM_CPU_HZ;
+
+		r.wake_overhead = (cfg->wake_cycles + cfg->post_sleep_cycles) / SIM_CPU_HZ;
+		r.avg_latency = char_time + echo_path + r.wake_overhead;
+		r.max_latency = r.avg_latency;
+		r.active_share = active < 1.0 ? active : 1.0;
+		idle_ma = cfg->sleep_ma;
+		break;
+	}
+
+	case SIM_MODE_STOP: {
+		// Characters starting before the USART is clocked again are lost,
+		// the one whose start bit woke the core included
+		double wake = cfg->stop_wake_us * 1e-6;
+		uint32_t lost = (uint32_t)(wake / char_time) + 1;
+		double active = cfg->rate * (wake + echo_path);
+
+		r.lost = lost < cfg->message ? lost : cfg->message;
+		r.wake_overhead = wake;
+		if (r.lost < cfg->message) {
+			r.avg_latency = char_time + echo_path;
+			r.max_latency = r.avg_latency;
+		}
+		r.active_share = active < 1.0 ? active : 1.0;
+		idle_ma = cfg->stop_ma;
+		break;
+	}
+	}
+
+	r.current_ma = r.active_share * cfg->run_ma + (1.0 - r.active_share) * idle_ma;
+	return r;
+}
+
+int main(int argc, char** argv)
+{
+	static const double bauds[] = { 9600, 115200, 921600 };
+	sim_config_t cfg = {
+		.message = 16,
+		.rate = 10,
+		.isr_cycles = 600,
+		.task_cycles = 1500,
+		.tx_cycles = 900,
+		.tick_cycles = 300,
+		.wake_cycles = 20,
+		.post_sleep_cycles = 60,
+		.tickless_cycles = 800,
+		.stop_wake_us = 2000,
+		.run_ma = 36.0,
+		.sleep_ma = 14.4,
+		.stop_ma = 0.024,
+	};
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--message") == 0)
+			cfg.message = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--rate") == 0)
+			cfg.rate = parse_double(argc, argv, &i);
+		else if (strcmp(argv[i], "--isr-cycles") == 0)
+			cfg.isr_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--task-cycles") == 0)
+			cfg.task_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--tx-cycles") == 0)
+			cfg.tx_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--tick-cycles") == 0)
+			cfg.tick_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--wake-cycles") == 0)
+			cfg.wake_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--post-sleep-cycles") == 0)
+			cfg.post_sleep_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--tickless-cycles") == 0)
+			cfg.tickless_cycles = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--stop-wake-us") == 0)
+			cfg.stop_wake_us = parse_arg(argc, argv, &i);
+		else if (strcmp(argv[i], "--run-ma") == 0)
+			cfg.run_ma = parse_double(argc, argv, &i);
+		else if (strcmp(argv[i], "--sleep-ma") == 0)
+			cfg.sleep_ma = parse_double(argc, argv, &i);
+		else if (strcmp(argv[i], "--stop-ma") == 0)
+			cfg.stop_ma = parse_double(argc, argv, &i);
+		else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+	if (cfg.message == 0) {
+		fprintf(stderr, "--message must be non-zero\n");
+		return 2;
+	}
+
+	printf("mode,baud,message,lost_chars,avg_latency_us,max_latency_us,wake_overhead_us,active_share,avg_current_ma\n");
+	for (size_t b = 0; b < sizeof(bauds)/sizeof(bauds[0]); b++) {
+		for (int mode = SIM_MODE_BUSY; mode <= SIM_MODE_STOP; mode++) {
+			sim_result_t r = sim_run(mode, bauds[b], &cfg);
+			if (r.lost == cfg.message)
+				printf("%s,%.0f,%u,%u,,,%.2f,%.6f,%.3f\n",
+					sim_mode_names[mode], bauds[b], cfg.message, r.lost,
+					r.wake_overhead * 1e6, r.active_share, r.current_ma);
+			else
+				printf("%s,%.0f,%u,%u,%.2f,%.2f,%.2f,%.6f,%.3f\n",
+					sim_mode_names[mode], bauds[b], cfg.message, r.lost,
+					r.avg_latency * 1e6, r.max_latency * 1e6,
+					r.wake_overhead * 1e6, r.active_share, r.current_ma);
+		}
+	}
+	return 0;
+}